@@ -8,11 +8,15 @@
 
 #include <asp/config.h>
 #include <asp/options.h>
+#include <asp/ui/diagnostics.h>
+#include <asp/ui/scheduler.h>
 #include <asp/ui/window.h>
 #include <asp/ui/logs.h>
 
 #include <boost/asio.hpp>
 
+#include <thread>
+
 namespace asp {
 
 class application {
@@ -34,6 +38,15 @@ public:
    ui::window &get_window() { return window_; };
    inputs::data &get_data() { return data_; }
 
+private:
+   void start_ingest_thread();
+
+   //! Move the new data into the UI, requesting a redraw if anything changed
+   void drain();
+
+   //! Plan the frame, drain the new data and draw, if the plan says so
+   ui::scheduler::plan frame();
+
 private:
    //! I/O Context
    context_t ctx_;
@@ -48,14 +61,26 @@ private:
    //! Application log messages
    ui::logs logs_;
 
+   //! Latency statistics
+   ui::diagnostics diagnostics_;
+
+   //! Splits the UI thread time between rendering and the I/O
+   ui::scheduler scheduler_;
+
    //! Parsed data container
    inputs::data data_;
 
+   //! Log file input
+   inputs::importer importer_;
+
    //! Serial port input
    inputs::serial serial_;
 
    //! Main application window
    ui::window window_;
+
+   //! Optional thread running the I/O context
+   std::thread ingest_thread_;
 };
 
 } // namespace ig
@@ -0,0 +1,218 @@
+/**
+ * @file   channels.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_CHANNELS_H
+#define INCLUDE_ASP_INPUTS_CHANNELS_H
+
+#include <asp/inputs/lod_pyramid.h>
+#include <asp/inputs/parser.h>
+#include <asp/inputs/segmented_buffer.h>
+#include <asp/inputs/sliding_extents.h>
+#include <asp/inputs/time_column.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace asp::inputs {
+
+using channel_id_t = std::uint32_t;
+
+//! Assigns dense integer IDs to channel names, in order of appearance
+class channel_registry {
+public:
+   static constexpr channel_id_t invalid_id = ~channel_id_t{0};
+
+public:
+   //! Find or add a channel, the second value is true for new channels
+   std::pair<channel_id_t, bool> intern(std::string_view name);
+
+   channel_id_t find(std::string_view name) const;
+
+   const std::string &name(channel_id_t id) const { return names_[id]; }
+   std::size_t size() const { return names_.size(); }
+
+private:
+   //! Deque never moves its elements, so the map keys stay valid
+   std::deque<std::string> names_{};
+   std::unordered_map<std::string_view, channel_id_t> ids_{};
+};
+
+//! Channel values, stored column-wise and indexed by the channel ID. Every
+//! value has a host timestamp, stored in a time column next to it.
+//! Channels are either real (float values), or integer (64-bit values, the
+//! sealed chunks narrowed down to the width their range needs). The first
+//! sample picks the kind, integer channels turn real on the first non-integer
+//! sample. Their history stays in the integer column, so the promotion is
+//! O(1) and lossless, and only the later samples are stored as floats.
+class channel_store {
+public:
+   using column_t = segmented_buffer<float>;
+   using integer_column_t = segmented_buffer<std::int64_t>;
+   using clock_t = time_column::clock_t;
+
+   enum class value_kind : unsigned char { real, integer };
+
+   struct retention {
+      //! Maximal number of samples per channel (0 - unlimited)
+      std::size_t max_samples{0};
+
+      //! Maximal sample age (zero - unlimited)
+      clock_t::duration max_age{};
+   };
+
+   //! Trailing window with tracked value ranges. Either the last samples
+   //! (counted by the largest end index), or the samples received in the
+   //! last age, if set. Zero in both means disabled.
+   struct window {
+      std::uint64_t samples{0};
+      clock_t::duration age{};
+   };
+
+   //! Size of the compressed history, before and after the compression
+   struct compression_stats {
+      std::uint64_t unpacked_bytes{0};
+      std::uint64_t packed_bytes{0};
+   };
+
+public:
+   channel_id_t intern(std::string_view name);
+
+   channel_id_t find(std::string_view name) const {
+      return registry_.find(name);
+   }
+
+   void append(channel_id_t id, float value) {
+      append(id, value, clock_t::now());
+   }
+
+   void append(channel_id_t id, float value, clock_t::time_point received);
+
+   void append_integer(channel_id_t id, std::int64_t value,
+                       clock_t::time_point received);
+
+   //! Parsed value, of either kind
+   void append(channel_id_t id, const number &value,
+               clock_t::time_point received) {
+      if (value.is_integer) {
+         append_integer(id, value.integer, received);
+      } else {
+         append(id, value.real, received);
+      }
+   }
+
+   void set_retention(const retention &policy);
+
+   //! Preallocate storage for the expected number of samples per channel,
+   //! applies to the channels added later as well
+   void reserve(std::size_t samples);
+
+   //! Keep about hot_samples newest samples per channel in memory, moving
+   //! the older ones into the spill file. The file has to outlive the store.
+   void set_spill(spill_file &file, std::size_t hot_samples);
+
+   //! Keep about hot_samples newest samples per channel uncompressed,
+   //! compressing the older values and timestamps
+   void set_compression(std::size_t hot_samples);
+
+   compression_stats compression(channel_id_t id) const;
+
+   //! Drop samples older than the retention age
+   void enforce_retention(clock_t::time_point now);
+
+   void set_window(const window &w);
+
+   //! Minimum and maximum of the channel's samples in the window, if any
+   std::optional<std::pair<float, float>> window_range(channel_id_t id);
+
+   //! Number of channels
+   std::size_t size() const { return columns_.size(); }
+
+   //! Largest end index of all channels
+   std::uint64_t end_index() const { return end_index_; }
+
+   //! Latest timestamp of all channels
+   clock_t::time_point latest() const { return latest_; }
+
+   //! Seconds since the first sample (after the last clear)
+   double seconds(clock_t::time_point time) const {
+      return std::chrono::duration<double>(time - origin_).count();
+   }
+
+   clock_t::time_point origin() const { return origin_; }
+
+   const std::string &name(channel_id_t id) const {
+      return registry_.name(id);
+   }
+
+   value_kind kind(channel_id_t id) const { return kinds_[id]; }
+
+   //! Values of a real channel. Promoted channels start the column at the
+   //! promotion, the older values are still in the integer column.
+   const column_t &values(channel_id_t id) const { return columns_[id]; }
+
+   //! Values of an integer channel, or the history of a promoted one
+   const integer_column_t &integers(channel_id_t id) const {
+      return integers_[id];
+   }
+
+   //! Value of either kind, by its absolute index
+   double value(channel_id_t id, std::uint64_t index) const {
+      if (kinds_[id] == value_kind::integer ||
+          index < columns_[id].first_index()) {
+         return static_cast<double>(integers_[id].at_index(index));
+      }
+      return columns_[id].at_index(index);
+   }
+   const time_column &times(channel_id_t id) const { return times_[id]; }
+
+   //! Decimated values, for drawing long histories
+   const lod_pyramid &lod(channel_id_t id) const { return lods_[id]; }
+
+   //! Drop all values, channel IDs stay valid
+   void clear();
+
+private:
+   std::uint64_t window_first(channel_id_t id) const;
+   void rebuild_extents(channel_id_t id);
+   void trim(channel_id_t id, std::uint64_t first_index);
+   void apply_cold_storage(channel_id_t id);
+   void appended(channel_id_t id, float value, clock_t::time_point received);
+   void promote(channel_id_t id);
+
+private:
+   channel_registry registry_{};
+   retention retention_{};
+   std::size_t reserve_{0};
+
+   spill_file *spill_{nullptr};
+   bool compress_{false};
+   std::size_t hot_samples_{0};
+
+   std::vector<value_kind> kinds_{};
+   std::vector<column_t> columns_{};
+   std::vector<integer_column_t> integers_{};
+   std::vector<time_column> times_{};
+   std::vector<lod_pyramid> lods_{};
+
+   std::uint64_t end_index_{0};
+   bool has_origin_{false};
+   clock_t::time_point origin_{};
+   clock_t::time_point latest_{};
+
+   window window_{};
+   std::vector<sliding_extents> extents_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_CHANNELS_H */
@@ -0,0 +1,64 @@
+/**
+ * @file   chunk_codec.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_CHUNK_CODEC_H
+#define INCLUDE_ASP_INPUTS_CHUNK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Lossless compression of sealed history chunks. Only specialized for the
+//! element types it makes sense for, segmented_buffer keeps the other ones
+//! uncompressed. encode() returns false if the values don't get any smaller,
+//! the output is unspecified then.
+template <typename T>
+struct chunk_codec {
+   static constexpr bool available = false;
+};
+
+//! Gorilla-style XOR compression: every value is XOR-ed with the previous
+//! one, and only the meaningful bits of the result are stored. Runs of equal
+//! values are stored as a single run length.
+template <>
+struct chunk_codec<float> {
+   static constexpr bool available = true;
+
+   static bool encode(const float *values, std::size_t count,
+                      std::vector<std::uint8_t> &out);
+   static void decode(const std::uint8_t *data, std::size_t size,
+                      float *values, std::size_t count);
+};
+
+//! Gorilla-style delta-of-delta compression, for the sample timestamps. Values
+//! arriving at a steady rate mostly take a single bit, runs of them even less.
+template <>
+struct chunk_codec<std::uint32_t> {
+   static constexpr bool available = true;
+
+   static bool encode(const std::uint32_t *values, std::size_t count,
+                      std::vector<std::uint8_t> &out);
+   static void decode(const std::uint8_t *data, std::size_t size,
+                      std::uint32_t *values, std::size_t count);
+};
+
+//! Narrowing of the integer values: every value is stored as an offset to the
+//! chunk minimum, using the narrowest width (8, 16 or 32 bits) holding the
+//! range of the chunk. Chunks with a wider range are not compressed.
+template <>
+struct chunk_codec<std::int64_t> {
+   static constexpr bool available = true;
+
+   static bool encode(const std::int64_t *values, std::size_t count,
+                      std::vector<std::uint8_t> &out);
+   static void decode(const std::uint8_t *data, std::size_t size,
+                      std::int64_t *values, std::size_t count);
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_CHUNK_CODEC_H */
@@ -7,13 +7,24 @@
 #define INCLUDE_ASP_INPUTS_DATA_H
 
 #include <asp/types.h>
+#include <asp/inputs/channels.h>
+#include <asp/inputs/name_filter.h>
+#include <asp/inputs/parse_errors.h>
+#include <asp/inputs/parser.h>
+#include <asp/inputs/producer.h>
+#include <asp/inputs/spill_file.h>
+#include <asp/render/line_renderer.h>
 #include <asp/ui/drawable.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
-#include <regex>
 #include <functional>
+#include <utility>
 
 namespace asp {
 
@@ -21,6 +32,8 @@ struct options;
 
 namespace ui {
 class logs;
+class latency_tracker;
+class frame_profiler;
 }
 
 namespace inputs {
@@ -32,6 +45,25 @@ public:
       std::string graph_filter{};
       bool follow{};
       int follow_window{};
+      double follow_seconds{};
+
+      //! Use the receive time as the X axis, instead of the sample index
+      bool time_axis{};
+
+      //! Retention policy, zero means unlimited
+      std::size_t keep_samples{0};
+      double keep_seconds{0};
+
+      //! Expected number of samples per channel, preallocated up front
+      std::size_t reserve_samples{0};
+
+      //! Move the history older than hot_samples into a memory-mapped file
+      //! in this directory (empty - keep everything in memory)
+      std::string spill_dir{};
+      std::size_t hot_samples{0};
+
+      //! Compress the history older than hot_samples
+      bool compress_history{};
 
       static po_desc_t prepare();
       static options load(po_vars_t &vm);
@@ -39,14 +71,49 @@ public:
 
    using data_change_cb = std::function<void(data &)>;
    using draw_plot_cb = std::function<void(data &)>;
-   using container_t = std::unordered_map<std::string, std::vector<float>>;
+   using container_t = channel_store;
+   using producer_ptr = std::shared_ptr<producer>;
+   using notify_cb = producer::notify_cb;
+
+   //! GPU copy of a channel, for the native line rendering
+   struct gpu_series {
+      std::unique_ptr<render::line_buffer> buffer{};
+
+      //! X axis the buffer was uploaded for
+      bool time_axis{false};
+      channel_store::clock_t::time_point origin{};
+   };
 
 public:
-   data(const asp::options &opts, ui::logs &logs);
+   data(const asp::options &opts,
+        boost::asio::io_context &ctx,
+        ui::logs &logs,
+        ui::latency_tracker &latency,
+        ui::frame_profiler &profiler);
 
 public:
    void draw() override;
-   void add_raw_entry(const std::string &entry);
+
+   //! Parse a single line, received at the given host time. Called from the
+   //! ingest thread (if enabled), the parsed samples are only added to the
+   //! plot data by the next drain().
+   void add_raw_entry(std::string_view entry,
+                      channel_store::clock_t::time_point received =
+                          channel_store::clock_t::now());
+
+   //! Move samples, published by the producers, into the plot data, and
+   //! drop the ones past the retention age. Has to be called from the UI
+   //! thread on every loop iteration, before drawing. Returns true if
+   //! anything was added.
+   bool drain();
+
+   //! Number of samples, waiting for the next drain(). UI thread only.
+   std::size_t queued_samples() const;
+
+   //! Register a producer, for adding samples from a background thread. Has
+   //! to be called from the UI thread, the producer is dropped once closed.
+   producer_ptr add_producer(
+       std::size_t capacity = producer::default_capacity);
 
    void set_data_change_callback(data_change_cb cb) {
       std::swap(cb, data_change_cb_);
@@ -56,6 +123,23 @@ public:
       std::swap(cb, draw_plot_cb_);
    }
 
+   //! Draw the plot lines straight from GPU buffers (null - with ImPlot).
+   //! Drops the buffers of the previous renderer, so it has to be called
+   //! while the GL context is still alive.
+   void set_line_renderer(render::line_renderer *renderer) {
+      line_renderer_ = renderer;
+      gpu_series_.clear();
+   }
+
+   //! Parsing runs on the UI thread, without the ingest thread: a full
+   //! ingest queue is drained right away instead of dropping samples, so a
+   //! short one is used. Has to be set before the I/O starts.
+   void set_inline_drain(bool enabled);
+
+   //! Called from the producer threads, once they have new samples published.
+   //! Applies to all producers, has to be set before any of them starts.
+   void set_notify_callback(notify_cb cb);
+
    container_t &get_plot_data() {
       return plot_data_;
    }
@@ -72,26 +156,82 @@ private:
    void draw_settings();
    void draw_plot();
    void update_limits();
+   void draw_compression();
+
+   channel_id_t parser_channel(std::size_t field, std::string_view name);
+   void add_sample(channel_id_t id, const number &value,
+                   channel_store::clock_t::time_point received);
+   void refresh_name_filter();
 
 private:
    data::options opts_;
    ui::logs *logs_;
+   ui::latency_tracker *latency_;
+   ui::frame_profiler *profiler_;
+   //! Cold history chunks, has to outlive the plot data
+   std::unique_ptr<spill_file> spill_;
    container_t plot_data_;
 
-   std::regex name_regex_;
-   std::regex graph_regex_;
+   //! Parsed samples, the channels are registered by the parser
+   producer_ptr ingest_;
+
+   //! Background producers, including the ingest one
+   std::vector<producer_ptr> producers_;
+
+   //! Samples, dropped by the closed producers
+   std::uint64_t dropped_{0};
+
+   bool inline_drain_{false};
+
+   //! Samples were drained by add_sample(), the next drain() reports them
+   bool drained_early_{false};
+
+   //! Parser channel ID of every field of the last line. Lines usually keep
+   //! the same layout, so comparing names is enough to skip the lookup.
+   std::vector<channel_id_t> field_ids_;
+
+   //! Receive time of the oldest sample, not drawn yet
+   bool has_undrawn_{false};
+   channel_store::clock_t::time_point oldest_undrawn_{};
+
+   name_filter name_filter_;
+   name_filter graph_filter_;
+
+   //! Graph filter verdicts, indexed by the plot data channel ID
+   filter_verdicts graph_verdicts_;
+
+   //! Name filter copy, used by the parser. Updated from name_filter_ once
+   //! the filter generation changes.
+   std::mutex filter_mutex_;
+   std::atomic<unsigned> filter_generation_{0};
+   unsigned parser_generation_{0};
+   name_filter parser_name_filter_;
+
+   //! Name filter verdicts, indexed by the parser channel ID
+   filter_verdicts parser_verdicts_;
+
+   //! Errors of the parsed lines, channels are the parser ones
+   parse_errors parse_errors_;
 
    std::string error_message_{};
 
+   render::line_renderer *line_renderer_{nullptr};
+   std::vector<gpu_series> gpu_series_{};
+   std::vector<render::line_buffer::vertex> line_staging_{};
+
    data_change_cb data_change_cb_{};
    draw_plot_cb draw_plot_cb_{};
+   notify_cb notify_cb_{};
 
    bool collapsed_{false};
    int plot_flags_;
    int x_axis_flags_;
    int y_axis_flags_;
-   int min_x_{0};
-   int max_x_{0};
+   double min_x_{0};
+   double max_x_{0};
+   bool has_y_limits_{false};
+   double min_y_{0};
+   double max_y_{0};
 };
 
 } // namespace inputs
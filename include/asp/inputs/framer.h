@@ -0,0 +1,110 @@
+/**
+ * @file   framer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_FRAMER_H
+#define INCLUDE_ASP_INPUTS_FRAMER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace asp::inputs {
+
+//! Splits a stream of raw bytes into lines.
+//! Complete lines are handed out as views, either directly into the fed chunk
+//! or into the carry-over buffer, so they are only valid during the callback.
+class framer {
+public:
+   static constexpr auto npos = std::string_view::npos;
+
+public:
+   explicit framer(std::string separator);
+
+public:
+   //! Scan the chunk for line separators, calling on_line(std::string_view)
+   //! for every complete line. Incomplete tail is kept until the next call.
+   template <typename F>
+   void feed(std::string_view chunk, F &&on_line);
+
+   //! Switch to a different separator, re-framing the pending data with it
+   template <typename F>
+   void set_separator(std::string separator, F &&on_line);
+
+   const std::string &separator() const { return separator_; }
+
+   //! Number of bytes waiting for a line separator
+   std::size_t pending() const { return carry_.size(); }
+
+   void reset() { carry_.clear(); }
+
+private:
+   std::size_t find(std::string_view where, std::size_t from = 0) const;
+
+private:
+   std::string separator_;
+
+   //! Incomplete line, carried over between the feed() calls
+   std::string carry_{};
+
+   //! Scratch space used while re-framing the carry-over data
+   std::string scratch_{};
+};
+
+template <typename F>
+void framer::feed(std::string_view chunk, F &&on_line) {
+   const auto sep_size = separator_.size();
+
+   if (!carry_.empty()) {
+      // The separator might start inside the carry-over data and end inside
+      // the new chunk, check the boundary region first.
+      const auto old_size = carry_.size();
+      const auto overlap = std::min(sep_size - 1, chunk.size());
+      const auto from = old_size > sep_size - 1 ? old_size - (sep_size - 1) : 0;
+
+      carry_.append(chunk.data(), overlap);
+      auto pos = find(carry_, from);
+      if (pos != npos && pos < old_size) {
+         on_line(std::string_view{carry_.data(), pos});
+         chunk.remove_prefix(pos + sep_size - old_size);
+         carry_.clear();
+      } else {
+         carry_.resize(old_size);
+
+         pos = find(chunk);
+         if (pos == npos) {
+            carry_.append(chunk.data(), chunk.size());
+            return;
+         }
+
+         carry_.append(chunk.data(), pos);
+         on_line(std::string_view{carry_});
+         chunk.remove_prefix(pos + sep_size);
+         carry_.clear();
+      }
+   }
+
+   std::size_t pos;
+   while ((pos = find(chunk)) != npos) {
+      on_line(chunk.substr(0, pos));
+      chunk.remove_prefix(pos + sep_size);
+   }
+
+   carry_.append(chunk.data(), chunk.size());
+}
+
+template <typename F>
+void framer::set_separator(std::string separator, F &&on_line) {
+   separator_ = std::move(separator);
+
+   std::swap(scratch_, carry_);
+   feed(scratch_, on_line);
+   scratch_.clear();
+}
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_FRAMER_H */
@@ -0,0 +1,164 @@
+/**
+ * @file   importer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_IMPORTER_H
+#define INCLUDE_ASP_INPUTS_IMPORTER_H
+
+#include <asp/types.h>
+#include <asp/inputs/channels.h>
+#include <asp/inputs/name_filter.h>
+#include <asp/inputs/parser.h>
+#include <asp/ui/drawable.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace asp {
+
+struct options;
+
+namespace ui {
+class logs;
+}
+
+namespace inputs {
+
+class data;
+
+//! Imports a previously recorded log file. The file is memory-mapped and split
+//! at line boundaries into chunks, which are parsed in parallel by a pool of
+//! worker threads. Parsed chunks are merged into the plot data in the file
+//! order by the UI thread, so the partial results show up while the import is
+//! still running.
+class importer : public ui::drawable {
+public:
+   using notify_cb = std::function<void()>;
+
+   struct options {
+      std::string file{};
+
+      //! Number of worker threads, zero means one per core
+      int threads{0};
+
+      //! Time between the imported lines on the time axis, the file carries
+      //! no timestamps
+      std::chrono::steady_clock::duration line_period{
+          std::chrono::milliseconds(1)};
+
+      static po_desc_t prepare();
+      static options load(po_vars_t &vm);
+   };
+
+public:
+   importer(const asp::options &opts, data &data, ui::logs &logs);
+   ~importer() override;
+
+   importer(const importer &) = delete;
+   importer &operator=(const importer &) = delete;
+
+public:
+   void draw() override;
+
+   //! Start parsing, does nothing without a file
+   void start();
+
+   //! Move the parsed chunks into the plot data, in the file order. Has to be
+   //! called from the UI thread, once per frame. Returns true if anything was
+   //! merged.
+   bool drain();
+
+   //! Called from the worker threads, once a chunk is parsed. Has to be set
+   //! before start().
+   void set_notify_callback(notify_cb cb) { std::swap(cb, notify_); }
+
+   bool done() const { return merged_ == chunks_.size(); }
+
+private:
+   //! Parsed chunk. Channel IDs are local to the chunk, so that workers don't
+   //! have to share a registry.
+   struct sample {
+      channel_id_t id;
+
+      //! Line index within the chunk
+      std::uint32_t line;
+      number value;
+   };
+
+   struct result {
+      std::vector<std::string> names{};
+      std::vector<sample> samples{};
+      std::size_t lines{0};
+      std::size_t errors{0};
+   };
+
+   struct chunk {
+      std::string_view text{};
+      std::unique_ptr<result> parsed{};
+   };
+
+   void split(std::string_view text);
+   void work();
+   std::unique_ptr<result> parse(std::string_view text) const;
+   bool merge(const result &parsed,
+              std::chrono::steady_clock::time_point deadline);
+   std::chrono::steady_clock::time_point line_time(std::uint64_t line) const;
+
+private:
+   options opts_;
+   data *data_;
+   ui::logs *logs_;
+
+   //! Line separator, the same as the serial port one
+   std::string separator_;
+   name_filter name_filter_;
+
+   std::unique_ptr<boost::interprocess::file_mapping> mapping_{};
+   boost::interprocess::mapped_region region_{};
+
+   std::vector<chunk> chunks_{};
+   std::vector<std::thread> workers_{};
+   notify_cb notify_{};
+
+   //! Next chunk to be parsed
+   std::atomic<std::size_t> next_{0};
+
+   //! Guards chunk::parsed and merged_ updates
+   std::mutex mutex_{};
+   std::condition_variable merged_cv_{};
+   std::size_t merged_{0};
+   std::size_t max_ahead_{0};
+   bool stop_{false};
+
+   //! Chunk being merged, possibly over several frames, and its channel ID
+   //! mapping
+   std::unique_ptr<result> merging_{};
+   std::size_t merge_pos_{0};
+   std::vector<channel_id_t> channel_map_{};
+
+   std::uint64_t bytes_merged_{0};
+   std::uint64_t lines_{0};
+   std::uint64_t errors_{0};
+   std::chrono::steady_clock::time_point started_{};
+   std::chrono::steady_clock::duration elapsed_{};
+};
+
+} // namespace inputs
+} // namespace asp
+
+#endif /* INCLUDE_ASP_INPUTS_IMPORTER_H */
@@ -0,0 +1,84 @@
+/**
+ * @file   lod_pyramid.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_LOD_PYRAMID_H
+#define INCLUDE_ASP_INPUTS_LOD_PYRAMID_H
+
+#include <asp/inputs/segmented_buffer.h>
+#include <asp/inputs/time_column.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Min/max decimation of a single channel, updated as samples are appended.
+//! Level k splits the samples into buckets of span(k) samples, indexed by the
+//! absolute bucket index (sample index / span). Every bucket keeps the
+//! extremes of its samples (NaN only if all of them are), so spikes survive
+//! any amount of decimation, and the timestamps of its first and last sample,
+//! so that drawing a zoomed-out time axis doesn't touch the (possibly cold)
+//! time column.
+class lod_pyramid {
+public:
+   using time_point = time_column::time_point;
+
+   struct bucket {
+      float min;
+      float max;
+      time_point first;
+      time_point last;
+   };
+
+   //! Levels are much shorter than the values, so they use smaller chunks
+   using level_t = segmented_buffer<bucket, 9>;
+
+   //! Level 0 buckets span 2^base_shift samples
+   static constexpr unsigned base_shift = 4;
+
+   //! Every next level bucket spans 2^level_shift buckets of the previous one
+   static constexpr unsigned level_shift = 2;
+
+   //! Add a new level once the top one has this many buckets
+   static constexpr std::size_t max_top_buckets = 64;
+
+public:
+   static std::uint64_t span(std::size_t level) {
+      return std::uint64_t{1} << (base_shift + level_shift * level);
+   }
+
+   //! Sample index has to be one past the previous one
+   void append(std::uint64_t index, float value, time_point received);
+
+   //! Drop buckets that end before the first_index sample
+   void trim(std::uint64_t first_index);
+
+   void clear() { levels_.clear(); }
+
+   //! Spill the cold parts of the levels, keeping about hot_samples worth of
+   //! the newest buckets in memory
+   void set_spill(spill_file &file, std::size_t hot_samples);
+
+   std::size_t levels() const { return levels_.size(); }
+   const level_t &level(std::size_t level) const { return levels_[level]; }
+
+   //! Coarsest level, spanning at most samples_per_pixel samples per bucket.
+   //! Returns levels() if the raw samples should be drawn instead.
+   std::size_t pick_level(double samples_per_pixel) const;
+
+private:
+   void add_level();
+
+private:
+   std::vector<level_t> levels_{};
+
+   spill_file *spill_{nullptr};
+   std::size_t hot_chunks_{0};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_LOD_PYRAMID_H */
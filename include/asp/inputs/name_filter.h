@@ -0,0 +1,64 @@
+/**
+ * @file   name_filter.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_NAME_FILTER_H
+#define INCLUDE_ASP_INPUTS_NAME_FILTER_H
+
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Channel name filter with std::regex_match semantics.
+//! Trivial patterns (match-all, a literal prefix or a list of literals) are
+//! recognized up front and matched without the regex engine.
+class name_filter {
+public:
+   //! Throws std::regex_error for invalid patterns
+   explicit name_filter(const std::string &pattern);
+
+public:
+   bool matches(std::string_view name) const;
+
+private:
+   enum class kind { all, prefix, literals, regex };
+
+   bool parse_trivial(std::string_view pattern);
+
+private:
+   kind kind_{kind::regex};
+   std::vector<std::string> literals_{};
+   std::regex regex_{};
+};
+
+//! Cached filter verdicts, indexed by the channel ID
+class filter_verdicts {
+public:
+   template <typename F>
+   bool get(std::size_t id, F &&compute) {
+      if (id >= verdicts_.size()) {
+         verdicts_.resize(id + 1, unknown);
+      }
+
+      auto &verdict = verdicts_[id];
+      if (verdict == unknown) {
+         verdict = compute() ? accepted : rejected;
+      }
+      return verdict == accepted;
+   }
+
+   void invalidate() { verdicts_.assign(verdicts_.size(), unknown); }
+
+private:
+   enum : signed char { unknown = -1, rejected = 0, accepted = 1 };
+
+   std::vector<signed char> verdicts_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_NAME_FILTER_H */
@@ -0,0 +1,84 @@
+/**
+ * @file   parse_errors.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_PARSE_ERRORS_H
+#define INCLUDE_ASP_INPUTS_PARSE_ERRORS_H
+
+#include <asp/inputs/channels.h>
+#include <asp/inputs/parser.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace asp {
+
+namespace ui {
+class logs;
+}
+
+namespace inputs {
+
+//! Parse error accounting. Errors are counted per kind and channel, and
+//! reported as one log summary per counter, a second after the first error,
+//! with the first offending line attached. A noisy input costs a counter
+//! increment per bad field, instead of a formatted log entry. The summaries
+//! are flushed by a timer on the I/O context, so both have to be used from
+//! the thread running it.
+class parse_errors {
+public:
+   using clock_t = channel_store::clock_t;
+   using name_fn = std::function<std::string_view(channel_id_t)>;
+
+   //! Channel of the errors, that can't be attributed to one
+   static constexpr channel_id_t no_channel = channel_registry::invalid_id;
+
+public:
+   //! Channel names are only looked up with name_of, once reporting
+   parse_errors(boost::asio::io_context &ctx, ui::logs &logs,
+                name_fn name_of);
+
+public:
+   void record(parse_error ec, channel_id_t channel, std::string_view line);
+
+   std::uint64_t total() const { return total_; }
+
+private:
+   struct counter {
+      std::uint64_t count{0};
+      std::string sample{};
+   };
+
+   static constexpr std::size_t kinds =
+       static_cast<std::size_t>(parse_error::line_too_long) + 1;
+
+   //! Log the summaries of the errors, recorded since the last flush
+   void flush();
+   void report(parse_error ec, std::string_view channel, const counter &c,
+               double seconds);
+
+private:
+   ui::logs *logs_;
+   name_fn name_of_;
+   boost::asio::steady_timer timer_;
+
+   //! Counters since the last flush, indexed by (channel + 1) * kinds + kind
+   std::vector<counter> counters_{};
+   bool pending_{false};
+   clock_t::time_point first_{};
+
+   std::uint64_t total_{0};
+};
+
+} // namespace inputs
+} // namespace asp
+
+#endif /* INCLUDE_ASP_INPUTS_PARSE_ERRORS_H */
@@ -0,0 +1,91 @@
+/**
+ * @file   parser.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_PARSER_H
+#define INCLUDE_ASP_INPUTS_PARSER_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace asp::inputs {
+
+enum class parse_error {
+   none,
+   bad_number,
+   out_of_range,
+   missing_separator,
+   missing_name,
+   line_too_long,
+};
+
+const char *to_string(parse_error ec);
+
+//! Parsed value. Integers are kept exact, everything else is a float.
+struct number {
+   std::int64_t integer{0};
+   float real{0};
+   bool is_integer{false};
+
+   float as_float() const {
+      return is_integer ? static_cast<float>(integer) : real;
+   }
+};
+
+//! Parse a numeric value, without throwing or allocating. Surrounding
+//! whitespace is ignored, anything else following the number is an error.
+//! Hexadecimal values with a "0x" prefix are accepted, like std::stof does.
+parse_error parse_value(std::string_view text, float &value);
+
+//! Same as above, but values without a fraction or an exponent, fitting into
+//! 64 bits, are parsed as integers (hexadecimal ones included)
+parse_error parse_value(std::string_view text, number &value);
+
+//! Parse a "name:value(,name:value)*" line without allocating.
+//! For every field passing filter(name) either on_value(name, number) or
+//! on_error(field, parse_error) is called. Empty fields are skipped, fields
+//! without a name are reported as errors.
+template <typename F, typename V, typename E>
+void parse_line(std::string_view line, F &&filter, V &&on_value, E &&on_error) {
+   constexpr auto npos = std::string_view::npos;
+
+   while (!line.empty()) {
+      const auto end = line.find(',');
+      const auto field = line.substr(0, end);
+      line.remove_prefix(end == npos ? line.size() : end + 1);
+
+      if (field.empty()) {
+         continue;
+      }
+
+      const auto colon = field.find(':');
+      if (colon == npos) {
+         on_error(field, parse_error::missing_separator);
+         continue;
+      }
+
+      if (colon == 0) {
+         on_error(field, parse_error::missing_name);
+         continue;
+      }
+
+      const auto name = field.substr(0, colon);
+      if (!filter(name)) {
+         continue;
+      }
+
+      number value;
+      const auto ec = parse_value(field.substr(colon + 1), value);
+      if (ec != parse_error::none) {
+         on_error(field, ec);
+         continue;
+      }
+
+      on_value(name, value);
+   }
+}
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_PARSER_H */
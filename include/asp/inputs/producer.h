@@ -0,0 +1,136 @@
+/**
+ * @file   producer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_PRODUCER_H
+#define INCLUDE_ASP_INPUTS_PRODUCER_H
+
+#include <asp/inputs/channels.h>
+#include <asp/inputs/parser.h>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Lock-free handoff of samples from a single background thread to the UI
+//! thread. The producer publishes samples into a bounded SPSC queue and never
+//! waits: once the UI falls behind, new samples are dropped and counted. The
+//! UI thread drains everything published so far into the plot data before
+//! drawing, so the plot data only changes between frames, and every frame
+//! sees a consistent snapshot of all channels.
+class producer {
+public:
+   using clock_t = channel_store::clock_t;
+   using notify_cb = std::function<void()>;
+
+   //! Slots are preallocated, about 40 bytes each
+   static constexpr std::size_t default_capacity = 1 << 14;
+
+public:
+   explicit producer(std::size_t capacity = default_capacity)
+      : samples_{capacity} {}
+
+   producer(const producer &) = delete;
+   producer &operator=(const producer &) = delete;
+
+public:
+   //! Find or add a channel. Producer thread only.
+   channel_id_t channel(std::string_view name) {
+      return channels_.intern(name).first;
+   }
+
+   //! Producer thread only
+   const std::string &name(channel_id_t id) const { return channels_.name(id); }
+
+   //! Publish a sample, false if it was dropped. Producer thread only.
+   bool push(channel_id_t id, const number &value,
+             clock_t::time_point received = clock_t::now());
+
+   bool push(channel_id_t id, float value,
+             clock_t::time_point received = clock_t::now()) {
+      number n;
+      n.real = value;
+      return push(id, n, received);
+   }
+
+   //! No room for another sample. Producer thread only.
+   bool full() const { return samples_.write_available() == 0; }
+
+   //! Called by push(), once there are samples published since the last
+   //! drain. Has to be set before the producer thread starts.
+   void set_notify_callback(notify_cb cb) { std::swap(cb, notify_); }
+
+   //! No more samples are coming, the producer is dropped after the last
+   //! drain. Can be called from any thread.
+   void close() { closed_.store(true, std::memory_order_release); }
+
+   bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+   //! Number of samples dropped, because the UI was too slow
+   std::uint64_t dropped() const {
+      return dropped_.load(std::memory_order_relaxed);
+   }
+
+   //! Number of published, not yet drained samples. UI thread only.
+   std::size_t queued() const { return samples_.read_available(); }
+
+   //! Append the published samples to the store, calling on_sample(received)
+   //! for each of them. UI thread only.
+   template <typename F>
+   std::size_t drain(channel_store &store, F &&on_sample);
+
+private:
+   //! The first published sample of a channel carries its name, so the UI
+   //! thread never has to look into the producer's registry
+   struct sample {
+      channel_id_t id{};
+      const std::string *name{nullptr};
+      number value{};
+      clock_t::time_point received{};
+   };
+
+private:
+   //! Producer side
+   channel_registry channels_{};
+   std::vector<bool> announced_{};
+
+   boost::lockfree::spsc_queue<sample> samples_;
+   std::atomic<std::uint64_t> dropped_{0};
+   std::atomic<bool> closed_{false};
+
+   //! Set by the producer, cleared by the drain
+   std::atomic<bool> pending_{false};
+   notify_cb notify_{};
+
+   //! UI side: producer channel ID to the store channel ID
+   std::vector<channel_id_t> channel_map_{};
+};
+
+template <typename F>
+std::size_t producer::drain(channel_store &store, F &&on_sample) {
+   pending_.store(false);
+   return samples_.consume_all([&](const sample &s) {
+      if (s.name) {
+         if (s.id >= channel_map_.size()) {
+            channel_map_.resize(s.id + 1, channel_registry::invalid_id);
+         }
+         channel_map_[s.id] = store.intern(*s.name);
+      }
+
+      store.append(channel_map_[s.id], s.value, s.received);
+      on_sample(s.received);
+   });
+}
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_PRODUCER_H */
@@ -0,0 +1,80 @@
+/**
+ * @file   receive_buffer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_RECEIVE_BUFFER_H
+#define INCLUDE_ASP_INPUTS_RECEIVE_BUFFER_H
+
+#include <boost/asio/buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Receive buffer for the serial reader.
+//! Reads are appended at the head, flushed data is released from the tail and
+//! the buffer rewinds to the start once drained. Capacity doubles (up to the
+//! configured maximum) when reads keep filling all the space they are given.
+class receive_buffer {
+public:
+   struct stats {
+      std::uint64_t completions{0};
+      std::uint64_t bytes{0};
+      std::uint64_t flushes{0};
+      std::uint64_t grows{0};
+      std::size_t last_completion{0};
+      std::size_t max_completion{0};
+
+      double bytes_per_completion() const {
+         return completions ? static_cast<double>(bytes) / completions : 0.0;
+      }
+   };
+
+public:
+   receive_buffer(std::size_t initial_capacity, std::size_t max_capacity);
+
+public:
+   //! Free region for the next read
+   boost::asio::mutable_buffer prepare();
+
+   //! Account for bytes written into the region returned by prepare()
+   void commit(std::size_t bytes);
+
+   //! Bytes received but not flushed yet
+   std::string_view data() const {
+      return {storage_.data() + tail_, head_ - tail_};
+   }
+
+   //! Release everything returned by data()
+   void consume();
+
+   std::size_t size() const { return head_ - tail_; }
+   bool empty() const { return head_ == tail_; }
+   std::size_t capacity() const { return storage_.size(); }
+   std::size_t free_space() const { return storage_.size() - head_; }
+
+   const stats &get_stats() const { return stats_; }
+
+private:
+   //! Number of consecutive reads filling the whole region before growing
+   static constexpr int saturation_threshold = 4;
+
+   std::vector<char> storage_;
+   std::size_t max_capacity_;
+
+   std::size_t head_{0};
+   std::size_t tail_{0};
+
+   std::size_t requested_{0};
+   int saturated_{0};
+
+   stats stats_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_RECEIVE_BUFFER_H */
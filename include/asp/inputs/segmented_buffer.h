@@ -0,0 +1,532 @@
+/**
+ * @file   segmented_buffer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_SEGMENTED_BUFFER_H
+#define INCLUDE_ASP_INPUTS_SEGMENTED_BUFFER_H
+
+#include <asp/inputs/chunk_codec.h>
+#include <asp/inputs/spill_file.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Append-only buffer made of fixed-size, cache line aligned chunks, keeping
+//! track of the absolute index of every element. Elements never move: the
+//! buffer grows by adding chunks and drops the oldest elements by releasing
+//! chunks, so appending is never stalled by a reallocation.
+//! Element i (absolute) lives in chunk i / chunk_size.
+//! With compression enabled, chunks older than the newest few are compressed
+//! and decompressed on access into a small cache. With a spill file set, only
+//! the newest few chunks are kept in memory, older ones (compressed or not)
+//! are moved into the file.
+template <typename T, unsigned ChunkShift = 12>
+class segmented_buffer {
+public:
+   static constexpr std::size_t unlimited = 0;
+   static constexpr std::size_t chunk_size = std::size_t{1} << ChunkShift;
+   static constexpr std::size_t cache_line = 64;
+
+   //! Random access iterator over the elements
+   class const_iterator {
+   public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T *;
+      using reference = const T &;
+
+   public:
+      const_iterator() = default;
+      const_iterator(const segmented_buffer *owner, std::uint64_t index)
+         : owner_{owner}
+         , index_{index} {}
+
+   public:
+      reference operator*() const { return owner_->at_index(index_); }
+      pointer operator->() const { return &owner_->at_index(index_); }
+      reference operator[](difference_type n) const {
+         return owner_->at_index(index_ + n);
+      }
+
+      const_iterator &operator++() {
+         ++index_;
+         return *this;
+      }
+
+      const_iterator operator++(int) {
+         auto result = *this;
+         ++index_;
+         return result;
+      }
+
+      const_iterator &operator--() {
+         --index_;
+         return *this;
+      }
+
+      const_iterator operator--(int) {
+         auto result = *this;
+         --index_;
+         return result;
+      }
+
+      const_iterator &operator+=(difference_type n) {
+         index_ += n;
+         return *this;
+      }
+
+      const_iterator &operator-=(difference_type n) {
+         index_ -= n;
+         return *this;
+      }
+
+      friend const_iterator operator+(const_iterator it, difference_type n) {
+         return it += n;
+      }
+
+      friend const_iterator operator+(difference_type n, const_iterator it) {
+         return it += n;
+      }
+
+      friend const_iterator operator-(const_iterator it, difference_type n) {
+         return it -= n;
+      }
+
+      friend difference_type operator-(const const_iterator &a,
+                                       const const_iterator &b) {
+         return static_cast<difference_type>(a.index_ - b.index_);
+      }
+
+      friend bool operator==(const const_iterator &a, const const_iterator &b) {
+         return a.index_ == b.index_;
+      }
+
+      friend bool operator!=(const const_iterator &a, const const_iterator &b) {
+         return a.index_ != b.index_;
+      }
+
+      friend bool operator<(const const_iterator &a, const const_iterator &b) {
+         return a.index_ < b.index_;
+      }
+
+      friend bool operator>(const const_iterator &a, const const_iterator &b) {
+         return a.index_ > b.index_;
+      }
+
+      friend bool operator<=(const const_iterator &a, const const_iterator &b) {
+         return a.index_ <= b.index_;
+      }
+
+      friend bool operator>=(const const_iterator &a, const const_iterator &b) {
+         return a.index_ >= b.index_;
+      }
+
+      //! Absolute index of the element
+      std::uint64_t index() const { return index_; }
+
+   private:
+      const segmented_buffer *owner_{nullptr};
+      std::uint64_t index_{0};
+   };
+
+public:
+   explicit segmented_buffer(std::size_t max_size = unlimited)
+      : max_size_{max_size} {}
+
+   segmented_buffer(const segmented_buffer &) = delete;
+   segmented_buffer &operator=(const segmented_buffer &) = delete;
+
+   segmented_buffer(segmented_buffer &&) = default;
+
+   //! Returns the own chunks to the spill file first, the defaulted
+   //! assignment would leak them
+   segmented_buffer &operator=(segmented_buffer &&other) {
+      if (this == &other) {
+         return *this;
+      }
+
+      release_chunks();
+
+      chunks_ = std::move(other.chunks_);
+      other.chunks_.clear();
+      spare_ = std::move(other.spare_);
+      max_size_ = other.max_size_;
+      compress_ = other.compress_;
+      pack_hot_ = other.pack_hot_;
+      spill_ = other.spill_;
+      spill_hot_ = other.spill_hot_;
+      packed_upto_ = std::exchange(other.packed_upto_, 0);
+      spilled_upto_ = std::exchange(other.spilled_upto_, 0);
+      packed_chunks_ = std::exchange(other.packed_chunks_, 0);
+      packed_bytes_ = std::exchange(other.packed_bytes_, 0);
+      cache_ = std::move(other.cache_);
+      cache_next_ = other.cache_next_;
+      for (auto &entry : other.cache_) {
+         entry.chunk = no_chunk;
+      }
+      first_chunk_ = other.first_chunk_;
+      first_index_ = other.first_index_;
+      size_ = std::exchange(other.size_, 0);
+      return *this;
+   }
+
+   //! Return the spilled chunks to the file
+   ~segmented_buffer() { release_chunks(); }
+
+public:
+   void push_back(const T &value) {
+      if (max_size_ != unlimited && size_ >= max_size_) {
+         // Full, drop the oldest element
+         drop_front(size_ - max_size_ + 1);
+      }
+
+      const auto idx = end_index();
+      const auto chunk_idx = idx >> ChunkShift;
+      if (chunks_.empty()) {
+         first_chunk_ = chunk_idx;
+      }
+
+      if (chunk_idx - first_chunk_ >= chunks_.size()) {
+         chunks_.push_back(acquire());
+         seal();
+      }
+
+      chunks_.back().data[idx & chunk_mask] = value;
+      ++size_;
+   }
+
+   //! Drop count oldest elements, releasing the chunks left behind
+   void drop_front(std::size_t count) {
+      count = std::min(count, size_);
+      if (count == 0) {
+         return;
+      }
+
+      first_index_ += count;
+      size_ -= count;
+
+      const auto first_chunk = first_index_ >> ChunkShift;
+      while (!chunks_.empty() && first_chunk_ < first_chunk) {
+         pop_front_chunk();
+         ++first_chunk_;
+      }
+   }
+
+   void clear() { reset(0); }
+
+   //! Drop all elements, the next one gets the first_index absolute index
+   void reset(std::uint64_t first_index) {
+      release_chunks();
+
+      for (auto &entry : cache_) {
+         entry.chunk = no_chunk;
+      }
+
+      first_index_ = first_index;
+      size_ = 0;
+   }
+
+   //! Change the size limit, dropping the oldest elements if necessary
+   void set_max_size(std::size_t max_size) {
+      max_size_ = max_size;
+      if (max_size_ != unlimited && size_ > max_size_) {
+         drop_front(size_ - max_size_);
+      }
+   }
+
+   //! Keep only the newest hot_chunks chunks in memory, spilling the older
+   //! ones into the file. The file has to outlive the buffer.
+   void set_spill(spill_file &file, std::size_t hot_chunks) {
+      spill_ = &file;
+      spill_hot_ = std::max<std::size_t>(hot_chunks, 1);
+      seal();
+   }
+
+   //! Keep only the newest hot_chunks chunks uncompressed. Has no effect for
+   //! the element types without a chunk_codec.
+   void set_compression(std::size_t hot_chunks) {
+      compress_ = chunk_codec<T>::available;
+      pack_hot_ = std::max<std::size_t>(hot_chunks, 1);
+      seal();
+   }
+
+   //! Number of compressed chunks
+   std::size_t packed_chunks() const { return packed_chunks_; }
+
+   //! Size of the compressed chunks, before and after the compression
+   std::uint64_t unpacked_bytes() const {
+      return static_cast<std::uint64_t>(packed_chunks_) * sizeof(chunk);
+   }
+   std::uint64_t packed_bytes() const { return packed_bytes_; }
+
+   //! Preallocate enough chunks for count more elements
+   void reserve(std::size_t count) {
+      const auto chunks = (count + chunk_size - 1) / chunk_size;
+      while (spare_.size() < chunks) {
+         spare_.emplace_back(new chunk);
+      }
+   }
+
+   //! Free the preallocated chunks, that are not used yet
+   void release_spare() { spare_.clear(); }
+
+   //! Element by the index relative to the oldest one
+   const T &operator[](std::size_t idx) const {
+      return at_index(first_index_ + idx);
+   }
+
+   //! Element by the absolute index
+   //! References to the compressed chunks are only valid until the next
+   //! access to another compressed chunk.
+   const T &at_index(std::uint64_t index) const {
+      const auto chunk_idx = index >> ChunkShift;
+      const auto &s =
+          chunks_[static_cast<std::size_t>(chunk_idx - first_chunk_)];
+      const T *data = s.data ? s.data : unpack(chunk_idx, s);
+      return data[index & chunk_mask];
+   }
+
+   //! First element of a chunk by its absolute index (element index /
+   //! chunk_size), read without decompressing the chunk. Elements of the
+   //! oldest chunk might have been dropped already.
+   const T &chunk_front(std::uint64_t chunk_idx) const {
+      const auto &s =
+          chunks_[static_cast<std::size_t>(chunk_idx - first_chunk_)];
+      return s.data ? s.data[0] : s.front;
+   }
+
+   T &back() {
+      const auto idx = end_index() - 1;
+      return chunks_.back().data[idx & chunk_mask];
+   }
+
+   std::size_t size() const { return size_; }
+   bool empty() const { return size_ == 0; }
+
+   //! Absolute index of the oldest element (number of elements ever dropped)
+   std::uint64_t first_index() const { return first_index_; }
+
+   //! Absolute index past the newest element (number of elements ever added)
+   std::uint64_t end_index() const { return first_index_ + size_; }
+
+   const_iterator begin() const { return {this, first_index_}; }
+   const_iterator end() const { return {this, end_index()}; }
+
+   //! Contiguous elements, starting at the absolute index and ending at the
+   //! end of its chunk or the newest element
+   std::pair<const T *, std::size_t> span_at(std::uint64_t index) const {
+      const auto chunk_end = (index | chunk_mask) + 1;
+      const auto last = std::min(chunk_end, end_index());
+      return {&at_index(index), static_cast<std::size_t>(last - index)};
+   }
+
+   //! Call f(data, count, first_index) for every contiguous span of the
+   //! elements in [first, last) absolute index range
+   template <typename F>
+   void for_each_span(std::uint64_t first, std::uint64_t last, F &&f) const {
+      first = std::max(first, first_index_);
+      last = std::min(last, end_index());
+      while (first < last) {
+         auto [data, count] = span_at(first);
+         count = std::min<std::size_t>(count,
+                                       static_cast<std::size_t>(last - first));
+         f(data, count, first);
+         first += count;
+      }
+   }
+
+private:
+   static constexpr std::uint64_t chunk_mask = chunk_size - 1;
+
+   struct alignas(cache_line) chunk {
+      T values[chunk_size];
+   };
+
+   using chunk_ptr = std::unique_ptr<chunk>;
+
+   //! Chunk either owned (hot), stored in the spill file as is, or
+   //! compressed. Compressed chunks have no data pointer, their bytes are
+   //! either owned, or stored in the spill file, and their first element is
+   //! kept aside for searching.
+   struct slot {
+      chunk_ptr owned;
+      T *data;
+      std::unique_ptr<std::uint8_t[]> packed{};
+      const std::uint8_t *packed_data{nullptr};
+      std::size_t packed_size{0};
+      T front{};
+   };
+
+   //! Decompressed chunk, by its absolute chunk index
+   struct cache_entry {
+      std::uint64_t chunk;
+      chunk_ptr data;
+   };
+
+   static constexpr std::uint64_t no_chunk = ~std::uint64_t{0};
+
+   slot acquire() {
+      chunk_ptr result;
+      if (spare_.empty()) {
+         result.reset(new chunk);
+      } else {
+         result = std::move(spare_.back());
+         spare_.pop_back();
+      }
+
+      auto data = result->values;
+      return {std::move(result), data};
+   }
+
+   //! Compress and spill the chunks past the hot ones. Cold chunks are
+   //! always the oldest ones, so it's enough to count them.
+   void seal() {
+      while (compress_ && chunks_.size() - packed_upto_ > pack_hot_) {
+         pack(chunks_[packed_upto_++]);
+      }
+
+      while (spill_ && chunks_.size() - spilled_upto_ > spill_hot_) {
+         spill(chunks_[spilled_upto_++]);
+      }
+   }
+
+   //! Chunks that don't get smaller are kept as is
+   void pack(slot &s) {
+      if constexpr (chunk_codec<T>::available) {
+         if (!s.owned) {
+            return;
+         }
+
+         if (!chunk_codec<T>::encode(s.data, chunk_size, scratch_)) {
+            return;
+         }
+
+         s.packed_size = scratch_.size();
+         s.packed.reset(new std::uint8_t[s.packed_size]);
+         std::copy(scratch_.begin(), scratch_.end(), s.packed.get());
+         s.packed_data = s.packed.get();
+         s.front = s.data[0];
+
+         release(std::move(s.owned));
+         s.data = nullptr;
+
+         ++packed_chunks_;
+         packed_bytes_ += s.packed_size;
+      }
+   }
+
+   void spill(slot &s) {
+      if (s.owned) {
+         s.data = static_cast<T *>(spill_->store(s.data, sizeof(chunk)));
+         release(std::move(s.owned));
+      } else if (s.packed) {
+         s.packed_data = static_cast<const std::uint8_t *>(
+             spill_->store(s.packed.get(), s.packed_size));
+         s.packed.reset();
+      }
+   }
+
+   const T *unpack(std::uint64_t chunk_idx, const slot &s) const {
+      for (const auto &entry : cache_) {
+         if (entry.chunk == chunk_idx) {
+            return entry.data->values;
+         }
+      }
+
+      auto &entry = cache_[cache_next_];
+      cache_next_ = (cache_next_ + 1) % cache_.size();
+
+      if (!entry.data) {
+         entry.data.reset(new chunk);
+      }
+
+      if constexpr (chunk_codec<T>::available) {
+         chunk_codec<T>::decode(s.packed_data, s.packed_size,
+                                entry.data->values, chunk_size);
+      }
+      entry.chunk = chunk_idx;
+      return entry.data->values;
+   }
+
+   void pop_front_chunk() {
+      auto &s = chunks_.front();
+      if (s.owned) {
+         release(std::move(s.owned));
+      } else if (s.packed_data) {
+         if (!s.packed) {
+            spill_->release(const_cast<std::uint8_t *>(s.packed_data),
+                            s.packed_size);
+         }
+         --packed_chunks_;
+         packed_bytes_ -= s.packed_size;
+      } else {
+         spill_->release(s.data, sizeof(chunk));
+      }
+
+      for (auto &entry : cache_) {
+         if (entry.chunk == first_chunk_) {
+            entry.chunk = no_chunk;
+         }
+      }
+
+      packed_upto_ -= packed_upto_ ? 1 : 0;
+      spilled_upto_ -= spilled_upto_ ? 1 : 0;
+      chunks_.pop_front();
+   }
+
+   void release_chunks() {
+      while (!chunks_.empty()) {
+         pop_front_chunk();
+      }
+   }
+
+   //! Keep a single chunk around, so that a full buffer with a size limit
+   //! recycles its chunks instead of allocating new ones
+   void release(chunk_ptr ptr) {
+      if (spare_.empty()) {
+         spare_.push_back(std::move(ptr));
+      }
+   }
+
+private:
+   std::deque<slot> chunks_{};
+   std::vector<chunk_ptr> spare_{};
+   std::size_t max_size_;
+
+   bool compress_{false};
+   std::size_t pack_hot_{1};
+
+   spill_file *spill_{nullptr};
+   std::size_t spill_hot_{1};
+
+   //! Number of the oldest chunks, past the compression (spilling) threshold
+   std::size_t packed_upto_{0};
+   std::size_t spilled_upto_{0};
+
+   std::size_t packed_chunks_{0};
+   std::uint64_t packed_bytes_{0};
+   std::vector<std::uint8_t> scratch_{};
+
+   //! Two entries, so that walking across a chunk border doesn't thrash
+   mutable std::array<cache_entry, 2> cache_{{{no_chunk, {}}, {no_chunk, {}}}};
+   mutable std::size_t cache_next_{0};
+
+   std::uint64_t first_chunk_{0};
+   std::uint64_t first_index_{0};
+   std::size_t size_{0};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_SEGMENTED_BUFFER_H */
@@ -8,13 +8,19 @@
 
 #include <asp/types.h>
 #include <asp/inputs/data.h>
+#include <asp/inputs/framer.h>
+#include <asp/inputs/receive_buffer.h>
 #include <asp/ui/drawable.h>
 
 #include <boost/asio.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 namespace asp {
 
@@ -33,6 +39,20 @@ public:
       bool mirror{false};
       std::string line_separator{"\n"};
 
+      //! Initial and maximal receive buffer sizes, in bytes
+      std::size_t read_buffer{256};
+      std::size_t max_read_buffer{64 * 1024};
+
+      //! Combine reads until coalesce_bytes are received or coalesce_us
+      //! microseconds have passed. Disabled if coalesce_us is zero.
+      std::size_t coalesce_bytes{0};
+      int coalesce_us{0};
+
+      //! Run the I/O context and the parsing pipeline on a separate thread,
+      //! optionally pinned to the ingest_cpu core (-1 - any core)
+      bool ingest_thread{false};
+      int ingest_cpu{-1};
+
       static po_desc_t prepare();
       static options load(po_vars_t &vm);
    };
@@ -41,34 +61,75 @@ public:
    serial(context_t &ctx,
           const asp::options &opts,
           data &data,
-          ui::logs &logs);
+          ui::logs &logs,
+          ui::latency_tracker &latency);
    ~serial();
 
 public:
+   //! Open the port and start reading, executed on the I/O context
    void start();
 
    void draw() override;
 
+   //! Received, but not yet framed bytes: the OS input queue and the
+   //! coalesced reads, as of the last read completion. Can be called from
+   //! any thread.
+   std::size_t pending_bytes() const {
+      return pending_bytes_.load(std::memory_order_relaxed);
+   }
+
 private:
+   using clock_t = std::chrono::steady_clock;
+
+   //! Shared with the UI, the port itself might be driven by the ingest
+   //! thread
+   struct shared_state {
+      std::string status{};
+      bool connected{false};
+      bool expand{false};
+      receive_buffer::stats stats{};
+      std::size_t buffer_capacity{0};
+   };
+
+private:
+   void open();
    void read_some();
-   void split_data(std::size_t bytes_read);
+   bool should_flush() const;
+   void schedule_flush();
+   void flush();
+   void split_data(std::string_view chunk, clock_t::time_point received);
    void close();
    void handle_separator_change();
 
    void set_error(const std::string &err);
+   void set_connected(bool connected);
 
 private:
    data *data_;
    ui::logs *logs_;
+   ui::latency_tracker *latency_;
+
+   //! Options used by the I/O context
    options opts_;
-   bool connected_{false};
+
+   //! Options edited by the UI, posted to the I/O context on change
+   options ui_opts_;
+
    bool collapsed_{false};
 
    boost::asio::serial_port serial_;
-   std::vector<char> buffer_;
-   std::string remainder_{};
-
-   std::string status_{};
+   boost::asio::steady_timer flush_timer_;
+   bool flush_scheduled_{false};
+   receive_buffer buffer_;
+   framer framer_;
+
+   //! End of every coalesced read in the receive buffer, and its completion
+   //! time. Lines are stamped with the time of the read that completed them.
+   std::vector<std::pair<std::size_t, clock_t::time_point>> read_marks_{};
+   std::atomic<std::size_t> pending_bytes_{0};
+
+   mutable std::mutex state_mutex_;
+   shared_state state_{};
 
    std::unique_ptr<line_separator_picker> line_separator_picker_;
    std::unique_ptr<baud_rate_picker> baud_rate_picker_;
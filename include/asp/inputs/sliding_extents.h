@@ -0,0 +1,69 @@
+/**
+ * @file   sliding_extents.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_SLIDING_EXTENTS_H
+#define INCLUDE_ASP_INPUTS_SLIDING_EXTENTS_H
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+
+namespace asp::inputs {
+
+//! Minimum and maximum of a sliding window of samples, in O(1) amortized time
+//! per sample. Each monotonic deque only keeps the samples that can still
+//! become an extreme once the older ones leave the window.
+class sliding_extents {
+public:
+   //! Sample indices have to be increasing
+   void push(std::uint64_t index, float value) {
+      if (std::isnan(value)) {
+         return;
+      }
+
+      while (!max_.empty() && max_.back().value <= value) {
+         max_.pop_back();
+      }
+      max_.push_back({index, value});
+
+      while (!min_.empty() && min_.back().value >= value) {
+         min_.pop_back();
+      }
+      min_.push_back({index, value});
+   }
+
+   //! Forget samples before the first_index
+   void evict(std::uint64_t first_index) {
+      while (!max_.empty() && max_.front().index < first_index) {
+         max_.pop_front();
+      }
+
+      while (!min_.empty() && min_.front().index < first_index) {
+         min_.pop_front();
+      }
+   }
+
+   void clear() {
+      min_.clear();
+      max_.clear();
+   }
+
+   bool empty() const { return max_.empty(); }
+   float min() const { return min_.front().value; }
+   float max() const { return max_.front().value; }
+
+private:
+   struct entry {
+      std::uint64_t index;
+      float value;
+   };
+
+   std::deque<entry> min_{};
+   std::deque<entry> max_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_SLIDING_EXTENTS_H */
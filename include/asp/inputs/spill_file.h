@@ -0,0 +1,74 @@
+/**
+ * @file   spill_file.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_SPILL_FILE_H
+#define INCLUDE_ASP_INPUTS_SPILL_FILE_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace asp::inputs {
+
+//! Memory-mapped temporary file, holding the cold history chunks. The file
+//! grows by fixed-size segments, each mapped separately, so blocks never
+//! move once stored. The OS pages them in on access and is free to evict
+//! them again, so only the hot part of the history stays resident. Blocks
+//! are stored in power of two sized slots, released slots are reused by the
+//! blocks of the same size class, so the file stops growing once the
+//! retention starts dropping chunks.
+class spill_file {
+public:
+   //! Creates a new file in the directory, throws on failure
+   explicit spill_file(const std::string &directory,
+                       std::size_t segment_size = 64 << 20);
+   ~spill_file();
+
+   spill_file(const spill_file &) = delete;
+   spill_file &operator=(const spill_file &) = delete;
+
+public:
+   //! Copy a block into the file, returns its mapped address
+   void *store(const void *data, std::size_t bytes);
+
+   //! Block, returned by store(), is no longer needed and can be reused
+   void release(void *block, std::size_t bytes);
+
+   const std::string &path() const { return path_; }
+
+   //! Bytes held by the stored blocks, rounded up to their slots
+   std::uint64_t used() const { return used_; }
+
+   //! File size
+   std::uint64_t size() const {
+      return static_cast<std::uint64_t>(segments_.size()) * segment_size_;
+   }
+
+private:
+   void add_segment();
+
+private:
+   std::string path_;
+   std::size_t segment_size_;
+
+   std::unique_ptr<boost::interprocess::file_mapping> mapping_{};
+   std::vector<boost::interprocess::mapped_region> segments_{};
+
+   //! Bytes used in the last segment
+   std::size_t tail_{0};
+   std::uint64_t used_{0};
+
+   //! Released blocks, by their slot size class
+   std::vector<std::vector<void *>> free_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_SPILL_FILE_H */
@@ -0,0 +1,85 @@
+/**
+ * @file   time_column.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_INPUTS_TIME_COLUMN_H
+#define INCLUDE_ASP_INPUTS_TIME_COLUMN_H
+
+#include <asp/inputs/segmented_buffer.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace asp::inputs {
+
+//! Non-decreasing sample timestamps, stored as 32-bit microsecond deltas to a
+//! base time. A new base (epoch) is started whenever a delta doesn't fit, so
+//! the column keeps the same indices as the value column next to it.
+class time_column {
+public:
+   using clock_t = std::chrono::steady_clock;
+   using time_point = clock_t::time_point;
+
+public:
+   explicit time_column(std::size_t max_size = 0)
+      : deltas_{max_size} {}
+
+public:
+   void push_back(time_point time);
+   void drop_front(std::size_t count);
+   void set_max_size(std::size_t max_size);
+   void reserve(std::size_t count) { deltas_.reserve(count); }
+
+   void set_spill(spill_file &file, std::size_t hot_samples) {
+      deltas_.set_spill(file, hot_samples / decltype(deltas_)::chunk_size);
+   }
+
+   void set_compression(std::size_t hot_samples) {
+      deltas_.set_compression(hot_samples / decltype(deltas_)::chunk_size);
+   }
+
+   std::uint64_t unpacked_bytes() const { return deltas_.unpacked_bytes(); }
+   std::uint64_t packed_bytes() const { return deltas_.packed_bytes(); }
+   void clear();
+
+   //! Timestamp of the sample with the absolute index
+   time_point at(std::uint64_t index) const;
+
+   time_point front() const { return at(first_index()); }
+   time_point back() const { return at(end_index() - 1); }
+
+   //! Absolute index of the first sample received no earlier than time,
+   //! end_index() if there is none. Binary search, O(log(size)): first over
+   //! the chunk boundaries, then within a single chunk, so that at most one
+   //! compressed chunk is decoded.
+   std::uint64_t lower_bound(time_point time) const;
+
+   std::size_t size() const { return deltas_.size(); }
+   bool empty() const { return deltas_.empty(); }
+   std::uint64_t first_index() const { return deltas_.first_index(); }
+   std::uint64_t end_index() const { return deltas_.end_index(); }
+
+private:
+   using delta_t = std::uint32_t;
+   using resolution_t = std::chrono::microseconds;
+
+   struct epoch {
+      std::uint64_t first_index;
+      time_point base;
+   };
+
+   const epoch &find_epoch(std::uint64_t index) const;
+   time_point to_time(std::uint64_t index, delta_t delta) const;
+   void trim_epochs();
+
+private:
+   segmented_buffer<delta_t> deltas_;
+   std::deque<epoch> epochs_{};
+};
+
+} // namespace asp::inputs
+
+#endif /* INCLUDE_ASP_INPUTS_TIME_COLUMN_H */
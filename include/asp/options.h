@@ -9,6 +9,9 @@
 #include <asp/types.h>
 #include <asp/inputs/serial.h>
 #include <asp/inputs/data.h>
+#include <asp/inputs/importer.h>
+#include <asp/ui/diagnostics.h>
+#include <asp/ui/scheduler.h>
 #include <asp/ui/window.h>
 
 namespace asp {
@@ -17,6 +20,9 @@ struct options {
    ui::window::options window;
    inputs::serial::options serial;
    inputs::data::options data;
+   inputs::importer::options importer;
+   ui::diagnostics::options diagnostics;
+   ui::scheduler::options scheduler;
 
    static result_t<options> load(int argc, char **argv);
 };
@@ -0,0 +1,79 @@
+/**
+ * @file   gl_stream.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_RENDER_DETAIL_GL_STREAM_H
+#define INCLUDE_ASP_RENDER_DETAIL_GL_STREAM_H
+
+#include <cstddef>
+#include <vector>
+
+struct ImDrawData;
+struct ImDrawList;
+
+namespace asp::render::detail {
+
+//! Skips the redundant state changes in the draw loop of the bundled GLES
+//! renderers. Only the state changed by the loop itself is tracked, so it has
+//! to be reset after anything else had a chance to touch it (user callbacks).
+class gl_state {
+public:
+   //! Forget the tracked state, the next changes are always applied
+   void reset();
+
+   void bind_texture(unsigned int texture);
+   void scissor(int x, int y, int width, int height);
+
+private:
+   bool texture_valid_{false};
+   unsigned int texture_{0};
+
+   bool scissor_valid_{false};
+   int scissor_[4]{};
+};
+
+//! Uploads the geometry of all the draw lists in a frame into a single vertex
+//! and a single index buffer. The buffers are orphaned before the upload, so
+//! the driver hands out fresh storage instead of waiting for the previous
+//! frame to finish drawing from it. The capacity only grows, to let the driver
+//! recycle the orphaned storage.
+class frame_stream {
+public:
+   void create();
+   void destroy();
+
+   //! Upload the frame, leaves both buffers bound
+   void upload(const ImDrawData &data);
+
+   unsigned int vertex_buffer() const { return vertices_.id; }
+   unsigned int index_buffer() const { return indices_.id; }
+
+   //! Byte offsets of the draw list data in the buffers
+   std::size_t vertex_offset(int list) const { return vertex_offsets_[list]; }
+   std::size_t index_offset(int list) const { return index_offsets_[list]; }
+
+private:
+   struct buffer {
+      unsigned int id{0};
+      std::size_t capacity{0};
+   };
+
+   static void reserve(unsigned int target, buffer &buffer, std::size_t size);
+
+private:
+   buffer vertices_{};
+   buffer indices_{};
+
+   std::vector<std::size_t> vertex_offsets_{};
+   std::vector<std::size_t> index_offsets_{};
+};
+
+//! Merges the draw command with the following ones, as long as they only
+//! differ in the element range, and it is contiguous. Returns the index of the
+//! last merged command, the merged element count is stored in elem_count.
+int merge_commands(const ImDrawList &list, int first, unsigned int &elem_count);
+
+} // namespace asp::render::detail
+
+#endif /* INCLUDE_ASP_RENDER_DETAIL_GL_STREAM_H */
@@ -6,6 +6,8 @@
 #ifndef INCLUDE_ASP_RENDER_FRONTEND_H
 #define INCLUDE_ASP_RENDER_FRONTEND_H
 
+#include <asp/render/line_renderer.h>
+
 #include <SDL2/SDL.h>
 
 #include <memory>
@@ -17,7 +19,9 @@ class backend;
 
 class frontend {
 public:
-   frontend(SDL_Window &window, SDL_GLContext context);
+   //! With gpu_lines set, a line renderer is created, if the GL version
+   //! supports it
+   frontend(SDL_Window &window, SDL_GLContext context, bool gpu_lines);
    ~frontend();
 
 public:
@@ -29,9 +33,13 @@ public:
 
    SDL_Window &window() { return *window_; }
 
+   //! Null if not requested or not supported
+   render::line_renderer *lines() { return lines_.get(); }
+
 private:
    SDL_Window *window_;
    std::unique_ptr<backend> backend_;
+   std::unique_ptr<render::line_renderer> lines_;
    std::string shader_version_;
 };
 
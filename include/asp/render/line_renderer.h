@@ -0,0 +1,123 @@
+/**
+ * @file   line_renderer.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_RENDER_LINE_RENDERER_H
+#define INCLUDE_ASP_RENDER_LINE_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+struct ImDrawList;
+struct ImDrawCmd;
+
+namespace asp::render {
+
+//! Samples of a single series, kept in a GL buffer. The buffer only grows by
+//! appending, so every sample is uploaded once. X coordinates are stored
+//! relative to the base, to keep the float precision.
+class line_buffer {
+public:
+   struct vertex {
+      float x;
+      float y;
+   };
+
+public:
+   line_buffer();
+   ~line_buffer();
+
+   line_buffer(const line_buffer &) = delete;
+   line_buffer &operator=(const line_buffer &) = delete;
+
+public:
+   //! Drop the uploaded samples, the next one appended has the first index
+   void reset(std::uint64_t first, double x_base);
+
+   //! Upload samples, following the last uploaded one
+   void append(const vertex *vertices, std::size_t count);
+
+   //! Absolute index of the first uploaded sample
+   std::uint64_t first_index() const { return first_; }
+   std::uint64_t end_index() const { return first_ + size_; }
+   bool empty() const { return size_ == 0; }
+
+   double x_base() const { return x_base_; }
+
+   unsigned int vertex_array() const { return vao_; }
+
+private:
+   void grow(std::size_t capacity);
+
+private:
+   unsigned int vao_{0};
+   unsigned int vbo_{0};
+
+   std::uint64_t first_{0};
+   std::size_t size_{0};
+   std::size_t capacity_{0};
+   double x_base_{0};
+};
+
+//! Draws line buffers as a part of the ImGui frame, one draw call per series.
+//! The draw is recorded as an ImDrawList callback, so it lands between the
+//! plot background and the plot decorations, clipped to the plot area.
+//! Requires OpenGL 3 or GLES 3.
+class line_renderer {
+public:
+   //! Maps the buffer coordinates (relative to its X base) to pixels:
+   //! pixel = value * scale + offset
+   struct transform {
+      double scale_x;
+      double offset_x;
+      double scale_y;
+      double offset_y;
+   };
+
+public:
+   line_renderer(const std::string &shader_version, bool es);
+   ~line_renderer();
+
+   line_renderer(const line_renderer &) = delete;
+   line_renderer &operator=(const line_renderer &) = delete;
+
+public:
+   //! Forget the previous frame draws, has to be called once per frame
+   void new_frame();
+
+   //! Draw count samples, starting with the absolute index first. The
+   //! buffer has to stay alive until the frame is rendered.
+   void draw(ImDrawList &draw_list, const line_buffer &buffer,
+             std::uint64_t first, std::size_t count, const transform &xform,
+             std::uint32_t color);
+
+   //! Number of draw calls in the last frame
+   std::size_t draw_calls() const { return draws_.size(); }
+
+private:
+   struct draw_cmd {
+      line_renderer *self;
+      unsigned int vao;
+      int first;
+      int count;
+      transform xform;
+      float color[4];
+   };
+
+   static void render(const ImDrawList *list, const ImDrawCmd *cmd);
+
+private:
+   unsigned int program_{0};
+   int transform_location_{-1};
+   int color_location_{-1};
+
+   //! Stable addresses, referenced by the draw list callbacks
+   std::deque<draw_cmd> draws_{};
+};
+
+} // namespace asp::render
+
+#endif /* INCLUDE_ASP_RENDER_LINE_RENDERER_H */
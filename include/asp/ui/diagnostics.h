@@ -0,0 +1,84 @@
+/**
+ * @file   diagnostics.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_UI_DIAGNOSTICS_H
+#define INCLUDE_ASP_UI_DIAGNOSTICS_H
+
+#include <asp/types.h>
+#include <asp/ui/drawable.h>
+#include <asp/ui/frame_profiler.h>
+#include <asp/ui/latency.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+namespace asp {
+
+struct options;
+
+namespace ui {
+
+//! Diagnostics panel: end-to-end sample latencies and per-frame stage times
+class diagnostics : public ui::drawable {
+public:
+   struct options {
+      //! Print the latency summary to the standard output every that many
+      //! seconds (0 - never)
+      int latency_report{0};
+
+      //! Start with the frame stage profiler enabled
+      bool profile_frames{false};
+
+      static po_desc_t prepare();
+      static options load(po_vars_t &vm);
+   };
+
+   using clock_t = latency_tracker::clock_t;
+
+public:
+   diagnostics(const asp::options &opts, boost::asio::io_context &ctx);
+   ~diagnostics() override;
+
+public:
+   void draw() override;
+
+   latency_tracker &latency() { return latency_; }
+   frame_profiler &profiler() { return profiler_; }
+
+   //! Current frame was presented, has to be called once per frame
+   void frame_swapped();
+
+   void print_latency(std::ostream &os) const;
+
+private:
+   void draw_latency();
+   void draw_profiler();
+
+   //! Histograms are rotated and reported on the I/O context, so the
+   //! statistics keep moving while no frames are presented
+   void schedule_rotation();
+   void schedule_report();
+
+private:
+   options opts_;
+   latency_tracker latency_{};
+   frame_profiler profiler_{};
+
+   //! Stacked stage times, scratch space for the graph
+   std::vector<float> frame_index_{};
+   std::vector<float> stacked_{};
+
+   boost::asio::steady_timer rotation_timer_;
+   boost::asio::steady_timer report_timer_;
+};
+
+} // namespace ui
+} // namespace asp
+
+#endif /* INCLUDE_ASP_UI_DIAGNOSTICS_H */
@@ -0,0 +1,137 @@
+/**
+ * @file   frame_profiler.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_UI_FRAME_PROFILER_H
+#define INCLUDE_ASP_UI_FRAME_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace asp::ui {
+
+//! Stages of a single UI loop iteration
+enum class frame_stage {
+   //! SDL event processing, without the idle waiting
+   events,
+
+   //! Moving the published samples and imported chunks into the plot data
+   drain,
+
+   //! Building the UI, except for the plot
+   ui,
+
+   //! data::draw_plot
+   plot,
+
+   //! ImGui rendering, frontend::render
+   render,
+
+   //! SDL_GL_SwapWindow
+   swap,
+
+   //! io_context polling, without the ingest thread
+   io,
+
+   count,
+};
+
+const char *to_string(frame_stage stage);
+
+//! Per-frame stage timings, kept in a fixed ring of frames. Stages are
+//! measured with scoped timers, nested ones are subtracted from the enclosing
+//! stage, so the stage times of a frame add up. Everything between two
+//! frame_done() calls is attributed to the frame. UI thread only.
+class frame_profiler {
+public:
+   using clock_t = std::chrono::steady_clock;
+
+   static constexpr auto stage_count =
+       static_cast<std::size_t>(frame_stage::count);
+   static constexpr std::size_t frame_count = 512;
+
+   //! Stage times of a frame, in milliseconds
+   using frame = std::array<float, stage_count>;
+
+   struct summary {
+      float min{0};
+      float avg{0};
+      float p99{0};
+   };
+
+   class scope {
+   public:
+      explicit scope(frame_profiler &profiler, frame_stage stage)
+         : profiler_{&profiler} {
+         profiler_->begin(stage);
+      }
+
+      ~scope() { profiler_->end(); }
+
+      scope(const scope &) = delete;
+      scope &operator=(const scope &) = delete;
+
+   private:
+      frame_profiler *profiler_;
+   };
+
+public:
+   //! Nothing is measured while disabled. Applied with the next frame, so
+   //! that every stage is begun and ended in the same mode.
+   void set_enabled(bool enabled) { requested_ = enabled; }
+   bool enabled() const { return requested_; }
+
+   scope measure(frame_stage stage) { return scope{*this, stage}; }
+
+   //! Start measuring a stage, stages can be nested
+   void begin(frame_stage stage);
+   void end();
+
+   //! Frame is presented, the following stages belong to the next one
+   void frame_done();
+
+   //! Number of the recorded frames, up to frame_count
+   std::size_t size() const { return size_; }
+
+   //! Recorded frame by age, zero is the oldest one
+   const frame &at(std::size_t idx) const {
+      return frames_[(next_ + frame_count - size_ + idx) % frame_count];
+   }
+
+   summary get_summary(frame_stage stage) const;
+
+private:
+   //! Deeper nesting is not measured
+   static constexpr std::size_t max_depth = 4;
+
+   struct open_stage {
+      frame_stage stage;
+      clock_t::time_point start;
+      clock_t::duration nested;
+   };
+
+private:
+   bool enabled_{false};
+   bool requested_{false};
+
+   //! Open stages, only the first max_depth of them are measured
+   std::array<open_stage, max_depth> open_{};
+   std::size_t depth_{0};
+
+   //! Frame being measured
+   frame current_{};
+
+   std::array<frame, frame_count> frames_{};
+   std::size_t next_{0};
+   std::size_t size_{0};
+
+   //! Scratch space for the percentiles
+   mutable std::vector<float> sorted_{};
+};
+
+} // namespace asp::ui
+
+#endif /* INCLUDE_ASP_UI_FRAME_PROFILER_H */
@@ -0,0 +1,115 @@
+/**
+ * @file   latency.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_UI_LATENCY_H
+#define INCLUDE_ASP_UI_LATENCY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace asp::ui {
+
+//! Rolling log-scale latency histogram. Recording is lock-free and can be
+//! done from any thread, every octave is split into four buckets, so the
+//! reported percentiles are at most 25% off.
+class latency_histogram {
+public:
+   using duration = std::chrono::microseconds;
+
+   struct summary {
+      std::uint64_t count{0};
+      duration p50{};
+      duration p99{};
+      duration max{};
+   };
+
+public:
+   void record(std::chrono::steady_clock::duration latency);
+
+   //! Forget the older half of the rolling window
+   void rotate();
+
+   //! Summary of the last two rotation periods
+   summary get_summary() const;
+
+private:
+   static constexpr unsigned sub_bits = 2;
+   static constexpr std::size_t bucket_count = 40 << sub_bits;
+
+   static std::size_t bucket_index(std::uint64_t us);
+   static std::uint64_t bucket_limit(std::size_t idx);
+
+   struct window {
+      std::array<std::atomic<std::uint32_t>, bucket_count> buckets{};
+      std::atomic<std::uint64_t> max{0};
+   };
+
+private:
+   std::array<window, 2> windows_{};
+   std::atomic<unsigned> current_{0};
+};
+
+//! Pipeline stages, measured from the serial read completion
+enum class latency_stage {
+   //! Line extracted by the framer
+   framed,
+
+   //! Line parsed
+   parsed,
+
+   //! Sample first drawn by a frame
+   drawn,
+
+   //! Frame with the sample presented by SDL_GL_SwapWindow
+   swapped,
+
+   count,
+};
+
+const char *to_string(latency_stage stage);
+
+class latency_tracker {
+public:
+   using clock_t = std::chrono::steady_clock;
+
+   static constexpr auto stage_count =
+       static_cast<std::size_t>(latency_stage::count);
+
+   //! Histograms should be rotated every period
+   static constexpr std::chrono::seconds rotation_period{5};
+
+public:
+   void record(latency_stage stage,
+               clock_t::time_point received,
+               clock_t::time_point now = clock_t::now()) {
+      histograms_[static_cast<std::size_t>(stage)].record(now - received);
+   }
+
+   //! Oldest sample, drawn by the current frame for the first time
+   void frame_drawn(clock_t::time_point oldest_received);
+
+   //! Current frame was presented, has to be called once per frame
+   void frame_swapped();
+
+   //! Forget the older half of every histogram, safe to call from any thread
+   void rotate();
+
+   latency_histogram::summary get_summary(latency_stage stage) const {
+      return histograms_[static_cast<std::size_t>(stage)].get_summary();
+   }
+
+private:
+   std::array<latency_histogram, stage_count> histograms_{};
+
+   bool frame_has_samples_{false};
+   clock_t::time_point frame_oldest_{};
+};
+
+} // namespace asp::ui
+
+#endif /* INCLUDE_ASP_UI_LATENCY_H */
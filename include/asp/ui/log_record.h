@@ -0,0 +1,113 @@
+/**
+ * @file   log_record.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_UI_LOG_RECORD_H
+#define INCLUDE_ASP_UI_LOG_RECORD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace asp::ui {
+
+//! Log argument, formatted as a hexadecimal number
+struct log_hex {
+   std::uint64_t value;
+};
+
+//! Log message, that is not formatted yet: a format string with a static
+//! storage duration, and the raw arguments. The format string doubles as the
+//! message ID, every "{}" in it is replaced with the next argument. String
+//! arguments are copied into the record and cut once it is full. The record
+//! is trivially copyable, so it can be passed through a lock-free queue.
+struct log_record {
+   static constexpr std::size_t max_args = 6;
+   static constexpr std::size_t text_size = 192;
+
+   enum class arg_type : std::uint8_t {
+      integer,
+      unsigned_integer,
+      hex,
+      real,
+      text,
+   };
+
+   union arg_value {
+      std::int64_t integer;
+      std::uint64_t unsigned_integer;
+      double real;
+      struct {
+         std::uint16_t offset;
+         std::uint16_t size;
+      } text;
+   };
+
+   const char *format;
+   std::uint8_t count;
+   std::uint16_t text_used;
+   arg_type types[max_args];
+   arg_value values[max_args];
+   char text[text_size];
+
+   //! Append the formatted message
+   void format_to(std::string &out) const;
+
+   template <typename... ARGS>
+   static log_record make(const char *format, const ARGS &...args) {
+      log_record record;
+      record.format = format;
+      record.count = 0;
+      record.text_used = 0;
+      (record.capture(args), ...);
+      return record;
+   }
+
+private:
+   template <typename T>
+   void capture(const T &value) {
+      if (count == max_args) {
+         return;
+      }
+
+      auto &arg = values[count];
+      auto &type = types[count];
+      ++count;
+
+      if constexpr (std::is_same_v<T, log_hex>) {
+         type = arg_type::hex;
+         arg.unsigned_integer = value.value;
+      } else if constexpr (std::is_floating_point_v<T>) {
+         type = arg_type::real;
+         arg.real = value;
+      } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+         type = arg_type::integer;
+         arg.integer = value;
+      } else if constexpr (std::is_integral_v<T>) {
+         type = arg_type::unsigned_integer;
+         arg.unsigned_integer = value;
+      } else {
+         static_assert(std::is_convertible_v<const T &, std::string_view>,
+                       "Unsupported log argument type");
+         const std::string_view str{value};
+         const auto size = std::min(str.size(), text_size - text_used);
+         std::memcpy(text + text_used, str.data(), size);
+
+         type = arg_type::text;
+         arg.text.offset = text_used;
+         arg.text.size = static_cast<std::uint16_t>(size);
+         text_used += static_cast<std::uint16_t>(size);
+      }
+   }
+};
+
+static_assert(std::is_trivially_copyable_v<log_record>);
+
+} // namespace asp::ui
+
+#endif /* INCLUDE_ASP_UI_LOG_RECORD_H */
@@ -6,44 +6,118 @@
 #ifndef INCLUDE_ASP_UI_LOGS_H
 #define INCLUDE_ASP_UI_LOGS_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <sstream>
 
 #include <asp/ui/drawable.h>
+#include <asp/ui/log_record.h>
+
+#include <boost/lockfree/queue.hpp>
 
 namespace asp::ui {
 
+//! Log panel. Entries are kept in a fixed-capacity ring, with the text stored
+//! in a single arena, so a noisy device can't grow the memory usage or the
+//! draw time without bounds. The oldest entries are dropped once either the
+//! entry ring or the arena is full.
+//!
+//! Messages are added as a format and raw arguments, through a preallocated
+//! lock-free queue, and only formatted once they are drawn or copied. The UI
+//! loop moves the queue into the ring with drain() on every iteration, even
+//! while nothing is drawn.
+//!
+//! The first message after each drain() calls the notify callback, which
+//! (with window::wake) takes the lock of the SDL event queue. The following
+//! ones, up to the next drain(), don't lock.
 class logs : public ui::drawable {
+public:
+   using notify_cb = std::function<void()>;
+
 public:
    logs();
 
 public:
    void draw() override;
-   void add_entry(const std::string &entry);
 
-   template <typename ... ARGS>
-   void add(ARGS ... args) {
-      std::ostringstream os;
-      do_format(os, args...);
-      add_entry(os.str());
+   //! Queue a message, without locking or allocating, from any thread. The
+   //! format has to be a string literal, every "{}" in it is replaced with
+   //! the next argument once the message is formatted.
+   template <std::size_t N, typename... ARGS>
+   void add(const char (&format)[N], const ARGS &...args) {
+      push(log_record::make(format, args...));
    }
 
-private:
-   template <typename T>
-   void do_format(std::ostream &os, T value) {
-      os << value;
+   //! Called once there are messages queued since the last drain() call
+   void set_notify_callback(notify_cb cb) { std::swap(cb, notify_); }
+
+   //! Move the queued messages into the ring. UI thread only. Returns true if
+   //! anything was added.
+   bool drain();
+
+   //! Number of entries in the ring
+   std::size_t size() const { return count_; }
+
+   //! Entries dropped to make room, or because the queue was full
+   std::uint64_t dropped() const {
+      return dropped_ + lost_.load(std::memory_order_relaxed);
    }
 
-   template <typename T, typename ... ARGS>
-   void do_format(std::ostream &os, T value, ARGS ... args) {
-      os << value;
-      do_format(os, args...);
+   //! Formatted entry by age, zero is the oldest one. UI thread only, the
+   //! view is valid until the next call.
+   std::string_view line(std::size_t idx) { return text(at(idx)); }
+
+private:
+   static constexpr std::size_t queue_capacity = 1024;
+
+   //! Location of the entry's log_record in the arena
+   struct entry {
+      std::size_t offset;
+      std::size_t size;
+   };
+
+   //! Entry by age, zero is the oldest one
+   const entry &at(std::size_t idx) const {
+      return entries_[(first_ + idx) % entries_.size()];
    }
 
+   //! Entry text, formatted into the scratch string
+   std::string_view text(const entry &e);
+
+   void push(const log_record &record);
+   void append(const char *data, std::size_t size);
+   void pop_oldest();
+   void clear();
 
 private:
-   std::vector<std::string> logs_{};
+   //! UI thread only, other threads only use the queue
+   std::vector<entry> entries_;
+   std::size_t first_{0};
+   std::size_t count_{0};
+
+   //! Entry text, written in order and wrapping around once the end is reached
+   std::vector<char> arena_;
+   std::size_t write_pos_{0};
+
+   //! Entries dropped to make room for the new ones
+   std::uint64_t dropped_{0};
+
+   std::string scratch_{};
+
+   //! Messages, not moved into the ring yet
+   boost::lockfree::queue<log_record,
+                          boost::lockfree::capacity<queue_capacity>>
+       queue_{};
+
+   //! Messages dropped, because the queue was full
+   std::atomic<std::uint64_t> lost_{0};
+
+   std::atomic<bool> changed_{false};
+   notify_cb notify_{};
    bool auto_scroll_{true};
    const std::string auto_scroll_id_;
    const std::string clear_id_;
@@ -0,0 +1,133 @@
+/**
+ * @file   scheduler.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef INCLUDE_ASP_UI_SCHEDULER_H
+#define INCLUDE_ASP_UI_SCHEDULER_H
+
+#include <asp/types.h>
+#include <asp/ui/drawable.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace asp {
+
+struct options;
+
+namespace ui {
+
+//! Splits the time of the UI thread between the rendering and the ingest.
+//! Every frame the backlog (bytes waiting to be read, samples waiting to be
+//! moved into the plot data) is compared to what is left of the frame, after
+//! the measured rendering cost. The result is the time the I/O context is
+//! allowed to run for, and whether the frame should be drawn at all.
+class scheduler : public ui::drawable {
+public:
+   using clock_t = std::chrono::steady_clock;
+
+   enum class policy {
+      //! Never miss a frame, ingest with the time left of it
+      latency,
+
+      //! Like latency, but only give the ingest a steady share of the frame,
+      //! so that frame times don't jump with the data rate
+      smooth,
+
+      //! Give up rendering frames while falling behind the input: the I/O
+      //! keeps using up its budget. Only without the ingest thread.
+      throughput,
+   };
+
+   struct options {
+      policy schedule{policy::smooth};
+
+      static po_desc_t prepare();
+      static options load(po_vars_t &vm);
+   };
+
+   //! Work, waiting for the UI thread
+   struct backlog {
+      //! Received, but not yet framed bytes
+      std::size_t pending_bytes{0};
+
+      //! Parsed samples, not yet moved into the plot data
+      std::size_t queued_samples{0};
+
+      bool empty() const { return pending_bytes == 0 && queued_samples == 0; }
+   };
+
+   //! Decision for the current frame
+   struct plan {
+      //! Upper bound for the I/O polling, it ends earlier once no handler
+      //! is ready
+      clock_t::duration ingest_budget{};
+      bool render{true};
+   };
+
+   struct stats {
+      //! Exponential moving averages
+      clock_t::duration frame_period{};
+      clock_t::duration draw_cost{};
+      clock_t::duration ingest_budget{};
+      clock_t::duration ingest_spent{};
+
+      backlog last_backlog{};
+
+      //! Frames, either drawn or given up by the throughput policy. Loop
+      //! iterations with nothing to draw don't count.
+      std::uint64_t frames{0};
+      std::uint64_t frames_given_up{0};
+
+      //! Runs of the I/O context, and the ones that used up their whole
+      //! budget
+      std::uint64_t ingest_runs{0};
+      std::uint64_t budget_exhausted{0};
+   };
+
+public:
+   explicit scheduler(const asp::options &opts);
+
+public:
+   void draw() override;
+
+   //! Decide on the current frame. Has to be called once per frame, before
+   //! running the I/O context.
+   plan begin_frame(const backlog &backlog);
+
+   //! The I/O context ran for that long
+   void ingest_done(clock_t::duration spent);
+
+   //! The I/O runs on the UI thread, between the frames. Frames are only
+   //! given up in this mode, with the ingest thread it doesn't gain anything.
+   void set_inline_ingest(bool enabled) { inline_ingest_ = enabled; }
+
+   //! Frame was drawn: draw is the rendering cost, without waiting for the
+   //! swap, swapped is the time the frame was presented
+   void frame_drawn(clock_t::duration draw, clock_t::time_point swapped);
+
+   const stats &get_stats() const { return stats_; }
+
+private:
+   clock_t::duration slack() const;
+
+private:
+   options opts_;
+   stats stats_{};
+
+   plan plan_{};
+   clock_t::time_point last_swap_{};
+   int skipped_in_row_{0};
+   int exhausted_in_row_{0};
+   bool inline_ingest_{false};
+};
+
+const char *to_string(scheduler::policy policy);
+
+} // namespace ui
+} // namespace asp
+
+#endif /* INCLUDE_ASP_UI_SCHEDULER_H */
@@ -6,6 +6,7 @@
 #ifndef INCLUDE_ASP_UI_WINDOW_H
 #define INCLUDE_ASP_UI_WINDOW_H
 
+#include <asp/ui/diagnostics.h>
 #include <asp/ui/drawable.h>
 
 #include <asp/inputs/data.h>
@@ -15,6 +16,8 @@
 #include <SDL2/SDL.h>
 #include <imgui.h>
 #include <implot.h>
+
+#include <chrono>
 #include <vector>
 #include <memory>
 
@@ -31,6 +34,15 @@ public:
       int width{1280};
       int height{900};
 
+      //! Only redraw if something has changed
+      bool on_change{false};
+
+      //! Frame rate limit (0 - vsync only)
+      int max_fps{0};
+
+      //! Draw the plot lines from GPU buffers
+      bool gpu_lines{false};
+
       static po_desc_t prepare();
       static options load(po_vars_t &vm);
    };
@@ -38,29 +50,78 @@ public:
 public:
    window(const asp::options &opts,
           logs &logs,
+          diagnostics &diagnostics,
           std::initializer_list<ui::drawable *> drawables);
    ~window();
 
+   //! Timing of the last drawn frame
+   struct frame_timing {
+      //! Rendering cost, without waiting for the swap
+      std::chrono::steady_clock::duration draw{};
+      std::chrono::steady_clock::time_point swapped{};
+   };
+
 public:
    bool can_stop() const { return stop_; }
-   void update();
+
+   //! Process the pending events and draw a frame, unless the window is
+   //! hidden, the frame rate limit is reached, or (in the on-change mode)
+   //! nothing has changed. In the on-change mode this blocks until there is
+   //! something to draw, or wake() is called. Returns true if a frame was
+   //! drawn. With render set to false only the pending events are processed.
+   bool update(bool render = true);
+
+   const frame_timing &last_frame() const { return last_frame_; }
+
+   //! Something has changed, the next update() has to draw a frame
+   void request_redraw();
+
+   //! Interrupt the waiting in update(). Can be called from any thread, even
+   //! after the window is gone.
+   static void wake();
+
+   //! Limit the waiting in update() to max_wait_ms (negative - no limit),
+   //! so that the caller gets to run its own work in between
+   void set_max_wait(int max_wait_ms) { max_wait_ms_ = max_wait_ms; }
+
+   //! False while the window is minimized or hidden
+   bool visible() const { return !hidden_; }
+
+   //! Null, unless the GPU lines are enabled and supported
+   render::line_renderer *get_line_renderer() { return frontend_->lines(); }
 
    void add_drawable(ui::drawable *drawable) {
       drawables_.push_back(drawable);
    }
 
 private:
+   using clock_t = std::chrono::steady_clock;
+
    void draw();
 
+   //! Wait up to timeout_ms (0 - don't wait) for the first event, then
+   //! process all the pending ones
+   void process_events(int timeout_ms);
+   void process_event(const SDL_Event &event);
+
 private:
    asp::ui::window::options options_;
 
    bool stop_{false};
+   bool hidden_{false};
+
+   //! Number of frames still to be drawn in the on-change mode. ImGui needs a
+   //! couple of frames to settle after an input.
+   int redraw_frames_{1};
+   int max_wait_ms_{-1};
+   clock_t::duration frame_interval_{};
+   clock_t::time_point next_frame_{};
+   frame_timing last_frame_{};
 
    SDL_Window *window_{nullptr};
    SDL_GLContext context_;
-   SDL_Event event_{};
    std::unique_ptr<render::frontend> frontend_;
+   diagnostics *diagnostics_;
    ImVec4 clear_color_{0.45f, 0.55f, 0.60f, 1.00f};
 
    std::vector<drawable *> drawables_;
@@ -6,39 +6,163 @@
 
 #include <asp/application.h>
 
+#if ASP_TARGET_OS(WINDOWS)
+#include <windows.h>
+#elif ASP_TARGET_OS(UNIX)
+#include <pthread.h>
+#endif
+
 using namespace asp;
 
+namespace {
+
+//! Longest the window waits for events without the ingest thread, the
+//! serial driver's buffer has to be read well before it fills up
+constexpr int max_io_wait_ms = 2;
+
+bool pin_thread(std::thread &thread, int cpu) {
+#if ASP_TARGET_OS(WINDOWS)
+   auto mask = static_cast<DWORD_PTR>(1) << cpu;
+   return SetThreadAffinityMask(thread.native_handle(), mask) != 0;
+#elif ASP_TARGET_OS(UNIX)
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) ==
+          0;
+#else
+   // No way of pinning a thread to a core on macOS
+   (void)thread;
+   (void)cpu;
+   return false;
+#endif
+}
+
+} // namespace
+
 application::application(options opts)
    : ctx_{}
    , keep_alive_{boost::asio::make_work_guard(ctx_)}
    , options_{std::move(opts)}
    , logs_{}
-   , data_{options_, logs_}
-   , serial_{ctx_, options_, data_, logs_}
-   , window_{options_, logs_, {&serial_, &logs_, &data_}} {
-   // Nothing to do here
+   , diagnostics_{options_, ctx_}
+   , scheduler_{options_}
+   , data_{options_, ctx_, logs_, diagnostics_.latency(),
+           diagnostics_.profiler()}
+   , importer_{options_, data_, logs_}
+   , serial_{ctx_, options_, data_, logs_, diagnostics_.latency()}
+   , window_{options_,
+             logs_,
+             diagnostics_,
+             {&serial_,
+              &importer_,
+              &logs_,
+              &data_,
+              &diagnostics_,
+              &scheduler_}} {
+   // Background threads wake the window up, if it is waiting for a change
+   data_.set_notify_callback(&ui::window::wake);
+   importer_.set_notify_callback(&ui::window::wake);
+   logs_.set_notify_callback(&ui::window::wake);
+
+   data_.set_line_renderer(window_.get_line_renderer());
 }
 
 application::~application() {
+   // GPU buffers have to go before the GL context
+   data_.set_line_renderer(nullptr);
+
    keep_alive_.reset();
    ctx_.stop();
+
+   if (ingest_thread_.joinable()) {
+      ingest_thread_.join();
+   }
+}
+
+void application::start_ingest_thread() {
+   ingest_thread_ = std::thread{[this] { ctx_.run(); }};
+
+   const auto cpu = options_.serial.ingest_cpu;
+   if (cpu >= 0) {
+      if (pin_thread(ingest_thread_, cpu)) {
+         logs_.add("Ingest thread pinned to CPU {}", cpu);
+      } else {
+         logs_.add("Failed to pin the ingest thread to CPU {}", cpu);
+      }
+   }
 }
 
 void application::run() {
+   // The window blocks while there is nothing to draw, so the I/O has to run
+   // on its own thread
+   bool ingest_thread = options_.serial.ingest_thread;
+   if (options_.window.on_change && !ingest_thread) {
+      logs_.add("On-change rendering, using the ingest thread");
+      ingest_thread = true;
+   }
+
+   // Same thread parses and drains the samples, nothing has to be dropped
+   data_.set_inline_drain(!ingest_thread);
+   scheduler_.set_inline_ingest(!ingest_thread);
+
    if (!options_.serial.port.empty()) {
       serial_.start();
    }
 
+   importer_.start();
+
+   if (ingest_thread) {
+      start_ingest_thread();
+
+      // The ingest budget doesn't apply, I/O runs on its own thread
+      while (!window_.can_stop()) {
+         frame();
+      }
+      return;
+   }
+
+   // The I/O is only serviced between the frames, so the window mustn't
+   // sleep for long while rate-limited or hidden
+   window_.set_max_wait(max_io_wait_ms);
+
    while (!window_.can_stop()) {
-      window_.update();
+      const auto plan = frame();
 
-      // Run context tasks within the desired frame rate interval
+      // Run context tasks within the scheduled budget
       auto now = std::chrono::steady_clock::now;
       auto start = now();
-      while (ctx_.poll_one()) {
-         if ((now() - start) > std::chrono::milliseconds(4)) {
-            break;
+      {
+         const auto timer = diagnostics_.profiler().measure(ui::frame_stage::io);
+         while (ctx_.poll_one()) {
+            if ((now() - start) > plan.ingest_budget) {
+               break;
+            }
          }
       }
+      scheduler_.ingest_done(now() - start);
+   }
+}
+
+void application::drain() {
+   const auto timer = diagnostics_.profiler().measure(ui::frame_stage::drain);
+
+   // Bitwise or: every source has to be drained
+   const bool changed =
+       data_.drain() | importer_.drain() | logs_.drain();
+   if (changed) {
+      window_.request_redraw();
+   }
+}
+
+ui::scheduler::plan application::frame() {
+   const auto plan = scheduler_.begin_frame(
+       {serial_.pending_bytes(), data_.queued_samples()});
+
+   drain();
+   if (window_.update(plan.render)) {
+      const auto &timing = window_.last_frame();
+      scheduler_.frame_drawn(timing.draw, timing.swapped);
    }
+   return plan;
 }
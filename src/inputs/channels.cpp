@@ -0,0 +1,299 @@
+/**
+ * @file   channels.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/channels.h>
+
+#include <algorithm>
+
+using namespace asp::inputs;
+
+namespace {
+
+template <typename Column>
+void drop_before(Column &column, std::uint64_t first_index) {
+   if (first_index > column.first_index()) {
+      column.drop_front(
+          static_cast<std::size_t>(first_index - column.first_index()));
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: channel_registry
+////////////////////////////////////////////////////////////////////////////////
+std::pair<channel_id_t, bool> channel_registry::intern(std::string_view name) {
+   auto it = ids_.find(name);
+   if (it != ids_.end()) {
+      return {it->second, false};
+   }
+
+   const auto id = static_cast<channel_id_t>(names_.size());
+   const auto &stored = names_.emplace_back(name);
+   ids_.emplace(stored, id);
+   return {id, true};
+}
+
+channel_id_t channel_registry::find(std::string_view name) const {
+   auto it = ids_.find(name);
+   return it == ids_.end() ? invalid_id : it->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: channel_store
+////////////////////////////////////////////////////////////////////////////////
+channel_id_t channel_store::intern(std::string_view name) {
+   auto [id, added] = registry_.intern(name);
+   if (added) {
+      kinds_.push_back(value_kind::real);
+      columns_.emplace_back(retention_.max_samples);
+      integers_.emplace_back(retention_.max_samples);
+      times_.emplace_back(retention_.max_samples);
+      columns_.back().reserve(reserve_);
+      times_.back().reserve(reserve_);
+      lods_.emplace_back();
+      extents_.emplace_back();
+
+      // Only the chunk being filled is kept at the full width
+      integers_.back().set_compression(1);
+
+      if (spill_ || compress_) {
+         apply_cold_storage(id);
+      }
+   }
+   return id;
+}
+
+void channel_store::append(channel_id_t id, float value,
+                           clock_t::time_point received) {
+   if (kinds_[id] == value_kind::integer) {
+      promote(id);
+   }
+
+   columns_[id].push_back(value);
+   appended(id, value, received);
+}
+
+void channel_store::append_integer(channel_id_t id, std::int64_t value,
+                                   clock_t::time_point received) {
+   auto &kind = kinds_[id];
+   if (kind == value_kind::real) {
+      if (!times_[id].empty()) {
+         append(id, static_cast<float>(value), received);
+         return;
+      }
+
+      // The preallocated chunks move over to the integer column
+      kind = value_kind::integer;
+      columns_[id].release_spare();
+      integers_[id].reserve(reserve_);
+      integers_[id].reset(times_[id].end_index());
+   }
+
+   integers_[id].push_back(value);
+   appended(id, static_cast<float>(value), received);
+}
+
+// The float column starts at the promotion, the integer one keeps serving the
+// older indices until the retention drops them
+void channel_store::promote(channel_id_t id) {
+   columns_[id].reset(times_[id].end_index());
+   kinds_[id] = value_kind::real;
+}
+
+void channel_store::appended(channel_id_t id, float value,
+                             clock_t::time_point received) {
+   auto &times = times_[id];
+   const auto first = times.first_index();
+   times.push_back(received);
+
+   auto &lod = lods_[id];
+   lod.append(times.end_index() - 1, value, times.back());
+   if (times.first_index() != first) {
+      lod.trim(times.first_index());
+
+      // History of a promoted channel doesn't get appends of its own
+      drop_before(integers_[id], times.first_index());
+   }
+
+   if (!has_origin_) {
+      has_origin_ = true;
+      origin_ = received;
+   }
+
+   end_index_ = std::max(end_index_, times.end_index());
+   latest_ = std::max(latest_, times.back());
+
+   if (window_.samples || window_.age != clock_t::duration::zero()) {
+      auto &extents = extents_[id];
+      extents.push(times.end_index() - 1, value);
+      extents.evict(window_first(id));
+   }
+}
+
+void channel_store::set_retention(const retention &policy) {
+   retention_ = policy;
+   for (std::size_t id = 0; id < columns_.size(); ++id) {
+      columns_[id].set_max_size(retention_.max_samples);
+      integers_[id].set_max_size(retention_.max_samples);
+      times_[id].set_max_size(retention_.max_samples);
+      lods_[id].trim(times_[id].first_index());
+   }
+}
+
+void channel_store::reserve(std::size_t samples) {
+   reserve_ = samples;
+   for (std::size_t id = 0; id < columns_.size(); ++id) {
+      if (kinds_[id] == value_kind::integer) {
+         integers_[id].reserve(reserve_);
+      } else {
+         columns_[id].reserve(reserve_);
+      }
+      times_[id].reserve(reserve_);
+   }
+}
+
+void channel_store::set_spill(spill_file &file, std::size_t hot_samples) {
+   spill_ = &file;
+   hot_samples_ = hot_samples;
+   for (channel_id_t id = 0; id < columns_.size(); ++id) {
+      apply_cold_storage(id);
+   }
+}
+
+void channel_store::set_compression(std::size_t hot_samples) {
+   compress_ = true;
+   hot_samples_ = hot_samples;
+   for (channel_id_t id = 0; id < columns_.size(); ++id) {
+      apply_cold_storage(id);
+   }
+}
+
+channel_store::compression_stats
+channel_store::compression(channel_id_t id) const {
+   compression_stats result;
+   result.unpacked_bytes = columns_[id].unpacked_bytes() +
+                           integers_[id].unpacked_bytes() +
+                           times_[id].unpacked_bytes();
+   result.packed_bytes = columns_[id].packed_bytes() +
+                         integers_[id].packed_bytes() +
+                         times_[id].packed_bytes();
+   return result;
+}
+
+void channel_store::apply_cold_storage(channel_id_t id) {
+   const auto hot_chunks = hot_samples_ / column_t::chunk_size;
+   if (compress_) {
+      columns_[id].set_compression(hot_chunks);
+      times_[id].set_compression(hot_samples_);
+   }
+
+   if (spill_) {
+      columns_[id].set_spill(*spill_, hot_chunks);
+      integers_[id].set_spill(*spill_, hot_chunks);
+      times_[id].set_spill(*spill_, hot_samples_);
+      lods_[id].set_spill(*spill_, hot_samples_);
+   }
+}
+
+void channel_store::enforce_retention(clock_t::time_point now) {
+   if (retention_.max_age == clock_t::duration::zero()) {
+      return;
+   }
+
+   const auto cutoff = now - retention_.max_age;
+   for (channel_id_t id = 0; id < columns_.size(); ++id) {
+      const auto &times = times_[id];
+      if (!times.empty() && times.front() < cutoff) {
+         trim(static_cast<channel_id_t>(id), times.lower_bound(cutoff));
+      }
+   }
+}
+
+void channel_store::trim(channel_id_t id, std::uint64_t first_index) {
+   // Columns of a promoted channel cover different index ranges
+   drop_before(columns_[id], first_index);
+   drop_before(integers_[id], first_index);
+   drop_before(times_[id], first_index);
+   lods_[id].trim(times_[id].first_index());
+}
+
+void channel_store::set_window(const window &w) {
+   if (w.samples == window_.samples && w.age == window_.age) {
+      return;
+   }
+
+   // Evicted samples are gone, so growing the window needs a rescan
+   const bool grown = w.samples > window_.samples || w.age > window_.age;
+   window_ = w;
+
+   const bool enabled =
+       window_.samples || window_.age != clock_t::duration::zero();
+   for (channel_id_t id = 0; id < extents_.size(); ++id) {
+      if (!enabled) {
+         extents_[id].clear();
+      } else if (grown) {
+         rebuild_extents(id);
+      }
+   }
+}
+
+std::optional<std::pair<float, float>>
+channel_store::window_range(channel_id_t id) {
+   auto &extents = extents_[id];
+   extents.evict(window_first(id));
+   if (extents.empty()) {
+      return std::nullopt;
+   }
+   return std::make_pair(extents.min(), extents.max());
+}
+
+std::uint64_t channel_store::window_first(channel_id_t id) const {
+   const auto &times = times_[id];
+   if (window_.age != clock_t::duration::zero()) {
+      return times.lower_bound(latest_ - window_.age);
+   }
+
+   const auto start =
+       end_index_ > window_.samples ? end_index_ - window_.samples : 0;
+   return std::max(start, times.first_index());
+}
+
+void channel_store::rebuild_extents(channel_id_t id) {
+   const auto end = times_[id].end_index();
+   auto &extents = extents_[id];
+
+   extents.clear();
+   for (auto idx = window_first(id); idx < end; ++idx) {
+      extents.push(idx, static_cast<float>(value(id, idx)));
+   }
+}
+
+void channel_store::clear() {
+   for (auto &column : columns_) {
+      column.clear();
+   }
+
+   for (auto &integers : integers_) {
+      integers.clear();
+   }
+
+   for (auto &times : times_) {
+      times.clear();
+   }
+
+   for (auto &lod : lods_) {
+      lod.clear();
+   }
+
+   for (auto &extents : extents_) {
+      extents.clear();
+   }
+
+   end_index_ = 0;
+   has_origin_ = false;
+   latest_ = {};
+}
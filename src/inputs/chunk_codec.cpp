@@ -0,0 +1,454 @@
+/**
+ * @file   chunk_codec.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/chunk_codec.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace asp::inputs;
+
+namespace {
+
+//! Longest run of repeated values (or deltas), stored with a single marker
+constexpr std::size_t run_bits = 16;
+constexpr std::size_t max_run = (std::size_t{1} << run_bits) + 1;
+
+//! Leading zeros and length of a new XOR window
+constexpr unsigned window_header_bits = 10;
+
+std::uint64_t low_bits(unsigned bits) {
+   return bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+}
+
+unsigned leading_zeros(std::uint32_t value) {
+   unsigned result = 0;
+   for (std::uint32_t bit = 0x80000000U; bit && !(value & bit); bit >>= 1) {
+      ++result;
+   }
+   return result;
+}
+
+unsigned trailing_zeros(std::uint32_t value) {
+   unsigned result = 0;
+   for (std::uint32_t bit = 1; bit && !(value & bit); bit <<= 1) {
+      ++result;
+   }
+   return result;
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+   return (static_cast<std::uint64_t>(value) << 1) ^
+          static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+   return static_cast<std::int64_t>(value >> 1) ^
+          -static_cast<std::int64_t>(value & 1);
+}
+
+//! MSB-first bit stream writer
+class bit_writer {
+public:
+   explicit bit_writer(std::vector<std::uint8_t> &out)
+      : out_{&out} {
+      out_->clear();
+   }
+
+public:
+   void write(std::uint64_t value, unsigned bits) {
+      while (bits) {
+         const auto take = std::min(bits, 64 - used_);
+         const auto part = (value >> (bits - take)) & low_bits(take);
+         acc_ = take == 64 ? part : (acc_ << take) | part;
+         used_ += take;
+         bits -= take;
+
+         if (used_ == 64) {
+            flush(8);
+         }
+      }
+   }
+
+   //! Write the run length (number of repeats), the first repeat is implied
+   void write_run(std::size_t run) {
+      if (run == 1) {
+         write(0, 1);
+      } else {
+         write(1, 1);
+         write(run - 2, run_bits);
+      }
+   }
+
+   void finish() {
+      if (used_) {
+         const auto bytes = (used_ + 7) / 8;
+         acc_ <<= 64 - used_;
+         flush(bytes);
+      }
+   }
+
+private:
+   void flush(unsigned bytes) {
+      for (unsigned i = 0; i < bytes; ++i) {
+         out_->push_back(static_cast<std::uint8_t>(acc_ >> (56 - i * 8)));
+      }
+      acc_ = 0;
+      used_ = 0;
+   }
+
+private:
+   std::vector<std::uint8_t> *out_;
+   std::uint64_t acc_{0};
+   unsigned used_{0};
+};
+
+//! MSB-first bit stream reader, reads zeroes past the end
+class bit_reader {
+public:
+   bit_reader(const std::uint8_t *data, std::size_t size)
+      : data_{data}
+      , size_{size} {}
+
+public:
+   std::uint64_t read(unsigned bits) {
+      std::uint64_t result = 0;
+      while (bits) {
+         const auto byte = pos_ >> 3;
+         const auto avail = 8 - static_cast<unsigned>(pos_ & 7);
+         const auto take = std::min(bits, avail);
+         const unsigned current = byte < size_ ? data_[byte] : 0;
+         result = (result << take) |
+                  ((current >> (avail - take)) & low_bits(take));
+         pos_ += take;
+         bits -= take;
+      }
+      return result;
+   }
+
+   bool read_bit() { return read(1) != 0; }
+
+   std::size_t read_run() {
+      return read_bit() ? static_cast<std::size_t>(read(run_bits)) + 2 : 1;
+   }
+
+private:
+   const std::uint8_t *data_;
+   std::size_t size_;
+   std::size_t pos_{0};
+};
+
+std::uint32_t float_bits(float value) {
+   std::uint32_t result;
+   std::memcpy(&result, &value, sizeof(result));
+   return result;
+}
+
+float bits_float(std::uint32_t bits) {
+   float result;
+   std::memcpy(&result, &bits, sizeof(result));
+   return result;
+}
+
+template <typename U>
+void narrow(const std::int64_t *values, std::size_t count, std::int64_t base,
+            std::uint8_t *out) {
+   for (std::size_t i = 0; i < count; ++i) {
+      const auto offset = static_cast<U>(
+          static_cast<std::uint64_t>(values[i]) -
+          static_cast<std::uint64_t>(base));
+      std::memcpy(out + i * sizeof(U), &offset, sizeof(U));
+   }
+}
+
+template <typename U>
+void widen(const std::uint8_t *data, std::size_t count, std::int64_t base,
+           std::int64_t *values) {
+   for (std::size_t i = 0; i < count; ++i) {
+      U offset;
+      std::memcpy(&offset, data + i * sizeof(U), sizeof(U));
+      values[i] = static_cast<std::int64_t>(static_cast<std::uint64_t>(base) +
+                                            offset);
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: chunk_codec<float>
+////////////////////////////////////////////////////////////////////////////////
+// Layout, after the first value stored as is:
+//    0 <run>                          - previous value repeated
+//    10 <meaningful bits>             - XOR fits into the previous window
+//    11 <5: leading> <5: length - 1> <meaningful bits>
+bool chunk_codec<float>::encode(const float *values, std::size_t count,
+                                std::vector<std::uint8_t> &out) {
+   bit_writer writer{out};
+   if (count == 0) {
+      return false;
+   }
+
+   auto prev = float_bits(values[0]);
+   writer.write(prev, 32);
+
+   unsigned lead = 0;
+   unsigned length = 0;
+
+   for (std::size_t i = 1; i < count;) {
+      const auto current = float_bits(values[i]);
+      const auto x = current ^ prev;
+
+      if (x == 0) {
+         std::size_t run = 1;
+         while (i + run < count && run < max_run &&
+                float_bits(values[i + run]) == prev) {
+            ++run;
+         }
+
+         writer.write(0, 1);
+         writer.write_run(run);
+         i += run;
+         continue;
+      }
+
+      const auto x_lead = leading_zeros(x);
+      const auto x_trail = trailing_zeros(x);
+      const auto x_length = 32 - x_lead - x_trail;
+
+      // A wide window, left over from an outlier, would cost every following
+      // value its full width. Start a new one as soon as that is cheaper.
+      const bool fits = length && x_lead >= lead &&
+                        x_trail >= 32 - lead - length &&
+                        length <= x_length + window_header_bits;
+
+      if (fits) {
+         writer.write(0b10, 2);
+         writer.write(x >> (32 - lead - length), length);
+      } else {
+         lead = x_lead;
+         length = x_length;
+         writer.write(0b11, 2);
+         writer.write(lead, 5);
+         writer.write(length - 1, 5);
+         writer.write(x >> x_trail, length);
+      }
+
+      prev = current;
+      ++i;
+   }
+
+   writer.finish();
+   return out.size() < sizeof(float) * count;
+}
+
+void chunk_codec<float>::decode(const std::uint8_t *data, std::size_t size,
+                                float *values, std::size_t count) {
+   bit_reader reader{data, size};
+   if (count == 0) {
+      return;
+   }
+
+   auto prev = static_cast<std::uint32_t>(reader.read(32));
+   values[0] = bits_float(prev);
+
+   unsigned lead = 0;
+   unsigned length = 0;
+
+   for (std::size_t i = 1; i < count;) {
+      if (!reader.read_bit()) {
+         const auto run = std::min(reader.read_run(), count - i);
+         std::fill_n(values + i, run, bits_float(prev));
+         i += run;
+         continue;
+      }
+
+      if (reader.read_bit()) {
+         lead = static_cast<unsigned>(reader.read(5));
+         length = static_cast<unsigned>(reader.read(5)) + 1;
+      }
+
+      const auto x = static_cast<std::uint32_t>(reader.read(length))
+                     << (32 - lead - length);
+      prev ^= x;
+      values[i++] = bits_float(prev);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: chunk_codec<std::uint32_t>
+////////////////////////////////////////////////////////////////////////////////
+// Layout, after the first value stored as is (the initial delta is zero):
+//    0 <run>                          - previous delta repeated
+//    10 <7>, 110 <9>, 1110 <12>, 1111 <36> - zigzag-encoded delta of delta
+bool chunk_codec<std::uint32_t>::encode(const std::uint32_t *values,
+                                        std::size_t count,
+                                        std::vector<std::uint8_t> &out) {
+   bit_writer writer{out};
+   if (count == 0) {
+      return false;
+   }
+
+   writer.write(values[0], 32);
+   std::int64_t prev_delta = 0;
+
+   auto delta = [&](std::size_t i) {
+      return static_cast<std::int64_t>(values[i]) -
+             static_cast<std::int64_t>(values[i - 1]);
+   };
+
+   for (std::size_t i = 1; i < count;) {
+      const auto current = delta(i);
+
+      if (current == prev_delta) {
+         std::size_t run = 1;
+         while (i + run < count && run < max_run &&
+                delta(i + run) == prev_delta) {
+            ++run;
+         }
+
+         writer.write(0, 1);
+         writer.write_run(run);
+         i += run;
+         continue;
+      }
+
+      const auto z = zigzag(current - prev_delta);
+      if (z < (1 << 7)) {
+         writer.write(0b10, 2);
+         writer.write(z, 7);
+      } else if (z < (1 << 9)) {
+         writer.write(0b110, 3);
+         writer.write(z, 9);
+      } else if (z < (1 << 12)) {
+         writer.write(0b1110, 4);
+         writer.write(z, 12);
+      } else {
+         writer.write(0b1111, 4);
+         writer.write(z, 36);
+      }
+
+      prev_delta = current;
+      ++i;
+   }
+
+   writer.finish();
+   return out.size() < sizeof(std::uint32_t) * count;
+}
+
+void chunk_codec<std::uint32_t>::decode(const std::uint8_t *data,
+                                        std::size_t size,
+                                        std::uint32_t *values,
+                                        std::size_t count) {
+   bit_reader reader{data, size};
+   if (count == 0) {
+      return;
+   }
+
+   values[0] = static_cast<std::uint32_t>(reader.read(32));
+   std::int64_t prev_delta = 0;
+
+   for (std::size_t i = 1; i < count;) {
+      if (!reader.read_bit()) {
+         const auto run = std::min(reader.read_run(), count - i);
+         for (std::size_t k = 0; k < run; ++k, ++i) {
+            values[i] = static_cast<std::uint32_t>(values[i - 1] + prev_delta);
+         }
+         continue;
+      }
+
+      unsigned bits = 36;
+      if (!reader.read_bit()) {
+         bits = 7;
+      } else if (!reader.read_bit()) {
+         bits = 9;
+      } else if (!reader.read_bit()) {
+         bits = 12;
+      }
+
+      prev_delta += unzigzag(reader.read(bits));
+      values[i] = static_cast<std::uint32_t>(values[i - 1] + prev_delta);
+      ++i;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: chunk_codec<std::int64_t>
+////////////////////////////////////////////////////////////////////////////////
+// Layout: <1: width> <8: base> <count * width: offsets to the base>
+bool chunk_codec<std::int64_t>::encode(const std::int64_t *values,
+                                       std::size_t count,
+                                       std::vector<std::uint8_t> &out) {
+   out.clear();
+   if (count == 0) {
+      return false;
+   }
+
+   const auto [min, max] = std::minmax_element(values, values + count);
+   const auto range =
+       static_cast<std::uint64_t>(*max) - static_cast<std::uint64_t>(*min);
+
+   std::uint8_t width = 8;
+   if (range <= 0xFF) {
+      width = 1;
+   } else if (range <= 0xFFFF) {
+      width = 2;
+   } else if (range <= 0xFFFFFFFF) {
+      width = 4;
+   }
+
+   if (width == 8) {
+      // Doesn't get any smaller, the caller keeps the chunk as is
+      return false;
+   }
+
+   const auto base = *min;
+   out.resize(1 + sizeof(base) + count * width);
+   out[0] = width;
+   std::memcpy(out.data() + 1, &base, sizeof(base));
+
+   auto data = out.data() + 1 + sizeof(base);
+   switch (width) {
+      case 1:
+         narrow<std::uint8_t>(values, count, base, data);
+         break;
+
+      case 2:
+         narrow<std::uint16_t>(values, count, base, data);
+         break;
+
+      default:
+         narrow<std::uint32_t>(values, count, base, data);
+         break;
+   }
+   return true;
+}
+
+void chunk_codec<std::int64_t>::decode(const std::uint8_t *data,
+                                       std::size_t size, std::int64_t *values,
+                                       std::size_t count) {
+   std::int64_t base;
+   if (count == 0 || size < 1 + sizeof(base)) {
+      return;
+   }
+
+   const auto width = data[0];
+   std::memcpy(&base, data + 1, sizeof(base));
+   data += 1 + sizeof(base);
+
+   switch (width) {
+      case 1:
+         widen<std::uint8_t>(data, count, base, values);
+         break;
+
+      case 2:
+         widen<std::uint16_t>(data, count, base, values);
+         break;
+
+      default:
+         widen<std::uint32_t>(data, count, base, values);
+         break;
+   }
+}
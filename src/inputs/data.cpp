@@ -6,15 +6,315 @@
 
 #include <asp/inputs/data.h>
 #include <asp/options.h>
+#include <asp/render/line_renderer.h>
+#include <asp/ui/frame_profiler.h>
+#include <asp/ui/latency.h>
 #include <asp/ui/logs.h>
 #include <asp/ui/std_input_text.h>
 
 #include <imgui.h>
 #include <implot.h>
+#include <implot_internal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 using namespace asp::inputs;
 using namespace std::string_literals;
 
+namespace {
+
+//! Maps channel samples onto the X axis: either the sample index, or the
+//! seconds since the first sample
+struct channel_view {
+   const channel_store *store;
+   channel_id_t id;
+
+   //! Null for the sample index axis
+   const time_column *times;
+
+   std::uint64_t first_index() const {
+      return store->times(id).first_index();
+   }
+
+   std::uint64_t end_index() const { return store->times(id).end_index(); }
+
+   double x(std::uint64_t idx) const {
+      if (!times) {
+         return static_cast<double>(idx);
+      }
+
+      idx = std::clamp(idx, times->first_index(), times->end_index() - 1);
+      return store->seconds(times->at(idx));
+   }
+
+   //! Integer values are only widened here, when handed to ImPlot
+   double y(std::uint64_t idx) const { return store->value(id, idx); }
+
+   //! First sample at or after the X axis position
+   std::uint64_t lower_bound(double pos) const {
+      const auto first = first_index();
+      const auto last = end_index();
+      if (pos <= x(first)) {
+         return first;
+      }
+      if (pos > x(last - 1)) {
+         return last;
+      }
+
+      if (!times) {
+         return static_cast<std::uint64_t>(std::ceil(pos));
+      }
+
+      using namespace std::chrono;
+      return times->lower_bound(
+          store->origin() +
+          duration_cast<channel_store::clock_t::duration>(
+              duration<double>(pos)));
+   }
+};
+
+//! Samples in [first, first + count) of a channel
+struct column_slice {
+   const channel_view *view;
+   std::uint64_t first;
+};
+
+ImPlotPoint column_getter(int idx, void *user_data) {
+   const auto &slice = *static_cast<const column_slice *>(user_data);
+   const auto abs_idx = slice.first + static_cast<std::uint64_t>(idx);
+   return {slice.view->x(abs_idx), slice.view->y(abs_idx)};
+}
+
+//! Buckets in [first, first + count) of a pyramid level
+struct lod_slice {
+   const channel_view *view;
+   const lod_pyramid::level_t *level;
+   std::uint64_t first;
+   std::uint64_t span;
+};
+
+//! Every bucket is drawn as two points: the minimum at the bucket start, and
+//! the maximum in the middle of it. Time axis positions come from the bucket
+//! itself, the time column might be cold.
+ImPlotPoint lod_getter(int idx, void *user_data) {
+   const auto &slice = *static_cast<const lod_slice *>(user_data);
+   const auto &level = *slice.level;
+   const auto abs_idx = slice.first + static_cast<std::uint64_t>(idx / 2);
+   const auto &bucket =
+       level[static_cast<std::size_t>(abs_idx - level.first_index())];
+
+   const auto &view = *slice.view;
+   const auto start = abs_idx * slice.span;
+   if (idx % 2) {
+      const auto x = view.times ? view.store->seconds(bucket.first +
+                                                      (bucket.last -
+                                                       bucket.first) / 2)
+                                : static_cast<double>(start + slice.span / 2);
+      return {x, bucket.max};
+   }
+
+   const auto x = view.times ? view.store->seconds(bucket.first)
+                             : static_cast<double>(start);
+   return {x, bucket.min};
+}
+
+//! GPU lines draw the raw samples up to this density, instead of the pyramid
+constexpr double gpu_samples_per_pixel = 64;
+
+//! Upper bound on the samples kept in a GPU buffer, once reached the buffer
+//! starts over with the latest half of them
+constexpr std::uint64_t max_gpu_samples = 1 << 24;
+
+//! Samples uploaded per frame and channel, a longer backlog is spread over
+//! several frames
+constexpr std::uint64_t gpu_upload_batch = 1 << 16;
+
+//! Ingest queue has to hold the samples arriving during a UI stall that long
+constexpr double ingest_stall_seconds = 0.25;
+
+//! Shortest line, e.g. "a:1\n", with a start and a stop bit per byte
+constexpr double min_sample_bits = 4 * 10;
+
+//! Upper bound on the ingest queue size, about 10 MB of slots
+constexpr std::size_t max_ingest_capacity = 1 << 18;
+
+//! Ingest queue without the ingest thread. It is drained once full, so the
+//! size only sets how often.
+constexpr std::size_t inline_ingest_capacity = 1 << 12;
+
+//! Ingest queue size for the serial port's configured rate
+std::size_t ingest_capacity(int baud_rate) {
+   const auto samples = static_cast<double>(std::max(baud_rate, 0)) /
+                        min_sample_bits * ingest_stall_seconds;
+
+   auto result = producer::default_capacity;
+   while (static_cast<double>(result) < samples &&
+          result < max_ingest_capacity) {
+      result <<= 1;
+   }
+   return result;
+}
+
+//! Longer lines are not parsed, usually a sign of a wrong baud rate or
+//! separator
+constexpr std::size_t max_line_size = 16 * 1024;
+
+using line_vertex = asp::render::line_buffer::vertex;
+
+//! Upload the next batch of the samples, not in the GPU buffer yet. The
+//! buffer starts at the first visible sample, so that it never has to
+//! catch up with the whole history.
+void sync_line(data::gpu_series &series, const channel_view &view,
+               std::uint64_t first_visible,
+               std::vector<line_vertex> &staging) {
+   auto &buffer = *series.buffer;
+   const auto end = view.end_index();
+   const bool time_axis = view.times != nullptr;
+   const auto origin = view.store->origin();
+
+   // Start over after the plot data or the X axis has changed, once the
+   // buffer is full, or when the view moves before its start
+   if (buffer.empty() || series.time_axis != time_axis ||
+       series.origin != origin || end < buffer.end_index() ||
+       first_visible < buffer.first_index() ||
+       end - buffer.first_index() > max_gpu_samples) {
+      buffer.reset(first_visible, view.x(first_visible));
+      series.time_axis = time_axis;
+      series.origin = origin;
+   }
+
+   const auto base = buffer.x_base();
+   const auto first = buffer.end_index();
+   const auto last = std::min(end, first + gpu_upload_batch);
+
+   staging.clear();
+   for (auto idx = first; idx < last; ++idx) {
+      staging.push_back({static_cast<float>(view.x(idx) - base),
+                         static_cast<float>(view.y(idx))});
+   }
+
+   if (!staging.empty()) {
+      buffer.append(staging.data(), staging.size());
+   }
+}
+
+//! Draw [first, last) of a channel straight from its GPU buffer, false if
+//! the buffer doesn't hold these samples
+bool plot_gpu_line(const std::string &name, std::uint64_t first,
+                   std::uint64_t last,
+                   asp::render::line_renderer &renderer,
+                   const data::gpu_series &series) {
+   const auto &buffer = *series.buffer;
+   if (first < buffer.first_index() || last > buffer.end_index()) {
+      return false;
+   }
+
+   if (!ImPlot::BeginItem(name.c_str(), ImPlotItemFlags_None,
+                          ImPlotCol_Line)) {
+      // Hidden via the legend
+      return true;
+   }
+
+   // Linear axes: pixel = position + (value - min) * pixels per unit
+   const auto limits = ImPlot::GetPlotLimits();
+   const auto pos = ImPlot::GetPlotPos();
+   const auto size = ImPlot::GetPlotSize();
+   const auto x_scale = size.x / limits.X.Size();
+   const auto y_scale = size.y / limits.Y.Size();
+
+   asp::render::line_renderer::transform xform;
+   xform.scale_x = x_scale;
+   xform.offset_x = pos.x + (buffer.x_base() - limits.X.Min) * x_scale;
+   xform.scale_y = -y_scale;
+   xform.offset_y = pos.y + limits.Y.Max * y_scale;
+
+   renderer.draw(*ImPlot::GetPlotDrawList(), buffer, first,
+                 static_cast<std::size_t>(last - first), xform,
+                 ImPlot::GetCurrentItem()->Color);
+
+   ImPlot::EndItem();
+   return true;
+}
+
+//! GPU line of a channel, if enabled
+struct gpu_line {
+   asp::render::line_renderer *renderer;
+   data::gpu_series *series;
+   std::vector<line_vertex> *staging;
+};
+
+//! Draw the part of a channel in the [x_min, x_max] range, decimating it so
+//! that the number of points is bound by the plot width in pixels
+void plot_channel(const std::string &name, const channel_view &view,
+                  const lod_pyramid &lod, double x_min, double x_max,
+                  double width, const gpu_line *gpu = nullptr) {
+   if (x_max < view.x(view.first_index()) ||
+       x_min > view.x(view.end_index() - 1)) {
+      // Nothing to draw, but keep the legend entry
+      const float none = 0;
+      ImPlot::PlotLine(name.c_str(), &none, 0);
+      return;
+   }
+
+   // Keep one sample past the edges, so that the line reaches them
+   auto first = view.lower_bound(x_min);
+   if (first > view.first_index()) {
+      --first;
+   }
+
+   auto last = view.lower_bound(x_max);
+   if (last < view.end_index()) {
+      ++last;
+   }
+
+   const auto samples_per_pixel =
+       static_cast<double>(last - first) / std::max(width, 1.0);
+
+   if (gpu && samples_per_pixel <= gpu_samples_per_pixel) {
+      sync_line(*gpu->series, view, first, *gpu->staging);
+      if (plot_gpu_line(name, first, last, *gpu->renderer, *gpu->series)) {
+         return;
+      }
+   }
+
+   const auto level_idx = lod.pick_level(samples_per_pixel);
+
+   if (level_idx == lod.levels()) {
+      const auto count = static_cast<int>(last - first);
+      const auto &store = *view.store;
+      const bool real = store.kind(view.id) == channel_store::value_kind::real;
+
+      // Promoted channels keep the older samples in the integer column
+      const auto &values = store.values(view.id);
+      if (!view.times && real && first >= values.first_index()) {
+         const auto [data, contiguous] = values.span_at(first);
+         if (contiguous >= static_cast<std::size_t>(count)) {
+            ImPlot::PlotLine(name.c_str(), data, count, 1.0,
+                             static_cast<double>(first));
+            return;
+         }
+      }
+
+      column_slice slice{&view, first};
+      ImPlot::PlotLineG(name.c_str(), column_getter, &slice, count);
+      return;
+   }
+
+   const auto &level = lod.level(level_idx);
+   const auto span = lod_pyramid::span(level_idx);
+   const auto first_bucket = std::max(first / span, level.first_index());
+   const auto last_bucket = std::min((last + span - 1) / span,
+                                     level.end_index());
+   lod_slice slice{&view, &level, first_bucket, span};
+   ImPlot::PlotLineG(name.c_str(), lod_getter, &slice,
+                     static_cast<int>((last_bucket - first_bucket) * 2));
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Class: data::options
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +333,22 @@ asp::po_desc_t data::options::prepare() {
         "Follow the head of the graph, displaying only the last --follow-window entries")
        ("follow-window", po::value<int>()->default_value(300),
         "Number of trailing entries to be displayed (has no effect without the --follow flag)")
+       ("follow-seconds", po::value<double>()->default_value(10.0),
+        "Number of trailing seconds to be displayed (has no effect without the --follow and --time-axis flags)")
+       ("time-axis,t",
+        "Place samples by their receive time instead of their index")
+       ("keep-samples", po::value<std::size_t>()->default_value(0),
+        "Keep only this many latest samples per channel (0 - keep everything)")
+       ("keep-seconds", po::value<double>()->default_value(0),
+        "Drop samples older than this many seconds (0 - keep everything)")
+       ("reserve-samples", po::value<std::size_t>()->default_value(0),
+        "Preallocate memory for this many samples per channel")
+       ("spill-dir", po::value<std::string>()->default_value(""),
+        "Move the older history into a memory-mapped file in this directory")
+       ("hot-samples", po::value<std::size_t>()->default_value(1 << 20),
+        "Number of the latest samples per channel to keep in memory uncompressed (has no effect without the --spill-dir or --compress-history)")
+       ("compress-history",
+        "Compress the history older than --hot-samples")
        ;
    // clang-format on
 
@@ -45,71 +361,200 @@ data::options data::options::load(po_vars_t &vm) {
    opts.graph_filter = vm["graph-filter"].as<std::string>();
    opts.follow = vm.count("follow");
    opts.follow_window = vm["follow-window"].as<int>();
+   opts.follow_seconds = vm["follow-seconds"].as<double>();
+   opts.time_axis = vm.count("time-axis");
+   opts.keep_samples = vm["keep-samples"].as<std::size_t>();
+   opts.keep_seconds = vm["keep-seconds"].as<double>();
+   opts.reserve_samples = vm["reserve-samples"].as<std::size_t>();
+   opts.spill_dir = vm["spill-dir"].as<std::string>();
+   opts.hot_samples = vm["hot-samples"].as<std::size_t>();
+   opts.compress_history = vm.count("compress-history");
    return opts;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Class: data
 ////////////////////////////////////////////////////////////////////////////////
-data::data(const asp::options &opts, ui::logs &logs)
+data::data(const asp::options &opts,
+           boost::asio::io_context &ctx,
+           ui::logs &logs,
+           ui::latency_tracker &latency,
+           ui::frame_profiler &profiler)
    : opts_{opts.data}
    , logs_{&logs}
-   , name_regex_{opts_.name_filter}
-   , graph_regex_{opts_.graph_filter} {
-   // Nothing to do here
+   , latency_{&latency}
+   , profiler_{&profiler}
+   , name_filter_{opts_.name_filter}
+   , graph_filter_{opts_.graph_filter}
+   , parser_name_filter_{name_filter_}
+   , parse_errors_{ctx, logs,
+                   [this](channel_id_t id) -> std::string_view {
+                      return ingest_->name(id);
+                   }} {
+   ingest_ = add_producer(ingest_capacity(opts.serial.baud_rate));
+
+   using namespace std::chrono;
+   channel_store::retention retention;
+   retention.max_samples = opts_.keep_samples;
+   retention.max_age = duration_cast<channel_store::clock_t::duration>(
+       duration<double>(std::max(opts_.keep_seconds, 0.0)));
+   plot_data_.set_retention(retention);
+   plot_data_.reserve(opts_.reserve_samples);
+
+   if (!opts_.spill_dir.empty()) {
+      try {
+         spill_ = std::make_unique<spill_file>(opts_.spill_dir);
+         plot_data_.set_spill(*spill_, opts_.hot_samples);
+         logs_->add("Spilling history to {}", spill_->path());
+      } catch (const std::exception &e) {
+         logs_->add("Unable to create a spill file: {}", e.what());
+      }
+   }
+
+   if (opts_.compress_history) {
+      plot_data_.set_compression(opts_.hot_samples);
+   }
 }
 
-void data::add_raw_entry(const std::string &entry) {
-   std::string name{};
-   std::string value{};
-   std::string *target = &name;
+void data::refresh_name_filter() {
+   auto generation = filter_generation_.load(std::memory_order_acquire);
+   if (generation == parser_generation_) {
+      return;
+   }
 
-   bool changed = false;
+   std::lock_guard<std::mutex> lock{filter_mutex_};
+   parser_name_filter_ = name_filter_;
+   parser_verdicts_.invalidate();
+   parser_generation_ = generation;
+}
 
-   auto add = [&] {
-      try {
-         if (std::regex_match(name, name_regex_)) {
-            auto result = std::stof(value);
-            plot_data_[name].push_back(result);
-            changed = true;
-         }
+channel_id_t data::parser_channel(std::size_t field, std::string_view name) {
+   if (field < field_ids_.size()) {
+      const auto id = field_ids_[field];
+      if (id != channel_registry::invalid_id &&
+          ingest_->name(id) == name) {
+         return id;
+      }
+   } else {
+      field_ids_.resize(field + 1, channel_registry::invalid_id);
+   }
 
-         name.clear();
-         value.clear();
-         target = &name;
-      } catch (const std::exception &e) {
-         logs_->add("Error parsing a value (", e.what(), "): ", value);
+   const auto id = ingest_->channel(name);
+   field_ids_[field] = id;
+   return id;
+}
+
+void data::add_sample(channel_id_t id, const number &value,
+                      channel_store::clock_t::time_point received) {
+   if (inline_drain_ && ingest_->full()) {
+      drained_early_ = drain();
+   }
+   ingest_->push(id, value, received);
+}
+
+bool data::drain() {
+   auto on_sample = [this](channel_store::clock_t::time_point received) {
+      if (!has_undrawn_) {
+         has_undrawn_ = true;
+         oldest_undrawn_ = received;
       }
    };
 
-   // (name: value,?)+
-   for (const auto ch : entry) {
-      if (ch == ':') {
-         target = &value;
-         continue;
-      }
+   std::size_t count = 0;
+   for (auto &p : producers_) {
+      // Check before draining, so that nothing published before closing is
+      // left behind
+      const bool closed = p->closed();
+      count += p->drain(plot_data_, on_sample);
 
-      if (ch == ',') {
-         add();
-         continue;
+      if (closed) {
+         dropped_ += p->dropped();
+         p.reset();
       }
+   }
+
+   producers_.erase(std::remove(producers_.begin(), producers_.end(), nullptr),
+                    producers_.end());
 
-      (*target) += ch;
+   // Runs on every loop iteration, also with nothing being drawn
+   plot_data_.enforce_retention(channel_store::clock_t::now());
+
+   if (count && data_change_cb_) {
+      data_change_cb_(*this);
    }
+   return count != 0 || std::exchange(drained_early_, false);
+}
 
-   if (!target->empty()) {
-      if (target == &value) {
-         add();
-      } else {
-         logs_->add("Invalid string: ", entry);
-      }
+std::size_t data::queued_samples() const {
+   std::size_t result = 0;
+   for (const auto &p : producers_) {
+      result += p->queued();
    }
+   return result;
+}
 
-   if (changed && data_change_cb_) {
-      data_change_cb_(*this);
+data::producer_ptr data::add_producer(std::size_t capacity) {
+   auto result = std::make_shared<producer>(capacity);
+   result->set_notify_callback(notify_cb_);
+   producers_.push_back(result);
+   return result;
+}
+
+void data::set_inline_drain(bool enabled) {
+   inline_drain_ = enabled;
+   if (!enabled) {
+      return;
+   }
+
+   // Nothing was parsed yet, so there are no channel IDs to keep
+   auto it = std::find(producers_.begin(), producers_.end(), ingest_);
+   producers_.erase(it);
+   field_ids_.clear();
+   ingest_ = add_producer(inline_ingest_capacity);
+}
+
+void data::set_notify_callback(notify_cb cb) {
+   std::swap(cb, notify_cb_);
+   for (auto &p : producers_) {
+      p->set_notify_callback(notify_cb_);
    }
 }
 
+void data::add_raw_entry(std::string_view entry,
+                         channel_store::clock_t::time_point received) {
+   refresh_name_filter();
+
+   if (entry.size() > max_line_size) {
+      parse_errors_.record(parse_error::line_too_long,
+                           parse_errors::no_channel, entry);
+      return;
+   }
+
+   std::size_t field = 0;
+   channel_id_t id;
+
+   auto filter = [&](std::string_view name) {
+      id = parser_channel(field++, name);
+      return parser_verdicts_.get(
+          id, [&] { return parser_name_filter_.matches(name); });
+   };
+
+   auto on_value = [&](std::string_view, const number &value) {
+      add_sample(id, value, received);
+   };
+
+   // Value errors belong to the channel, just passed by the filter
+   auto on_error = [&](std::string_view, parse_error ec) {
+      const auto bad_value = ec == parse_error::bad_number ||
+                             ec == parse_error::out_of_range;
+      parse_errors_.record(ec, bad_value ? id : parse_errors::no_channel,
+                           entry);
+   };
+
+   parse_line(entry, filter, on_value, on_error);
+   latency_->record(ui::latency_stage::parsed, received);
+}
+
 void data::draw() {
    draw_settings();
    draw_plot();
@@ -128,9 +573,9 @@ void data::draw_settings() {
       return;
    }
 
-   auto set_regex = [&](auto &ex, auto &text) {
+   auto set_filter = [&](auto &filter, auto &text) {
       try {
-         ex.assign(text);
+         filter = name_filter{text};
          return true;
       } catch (const std::exception &e) {
          error_message_ = "Filter error: "s + e.what();
@@ -151,19 +596,36 @@ void data::draw_settings() {
 
    next();
    if (ui::std_input_text("Name filter", opts_.name_filter)) {
-      name_error = !set_regex(name_regex_, opts_.name_filter);
+      std::lock_guard<std::mutex> lock{filter_mutex_};
+      name_error = !set_filter(name_filter_, opts_.name_filter);
+      if (!name_error) {
+         filter_generation_.fetch_add(1, std::memory_order_release);
+      }
    }
 
    next();
    ImGui::Checkbox("Follow", &opts_.follow);
    if (opts_.follow) {
       ImGui::SameLine();
-      ImGui::DragInt("Window", &opts_.follow_window, 10.0f, 100, 50000);
+      if (opts_.time_axis) {
+         float seconds = static_cast<float>(opts_.follow_seconds);
+         if (ImGui::DragFloat("Window, s", &seconds, 0.1f, 0.1f, 3600.0f)) {
+            opts_.follow_seconds = seconds;
+         }
+      } else {
+         ImGui::DragInt("Window", &opts_.follow_window, 10.0f, 100, 50000);
+      }
    }
 
+   next();
+   ImGui::Checkbox("Time axis", &opts_.time_axis);
+
    next();
    if (ui::std_input_text("Graph filter", opts_.graph_filter)) {
-      graph_error = !set_regex(graph_regex_, opts_.graph_filter);
+      graph_error = !set_filter(graph_filter_, opts_.graph_filter);
+      if (!graph_error) {
+         graph_verdicts_.invalidate();
+      }
    }
 
    if (!name_error && !graph_error) {
@@ -171,21 +633,9 @@ void data::draw_settings() {
    }
 
    if (opts_.follow) {
-      int max_entries = [&]() {
-         std::size_t result = 0;
-         for (const auto &kv : plot_data_) {
-            result = std::max(kv.second.size(), result);
-         }
-         return static_cast<int>(result);
-      }();
-
-      int min_x, max_x = max_entries;
-      if (max_entries < opts_.follow_window) {
-         min_x = 0;
-      } else {
-         min_x = max_entries - opts_.follow_window;
-      }
-      ImPlot::SetNextAxisLimits(ImAxis_X1, min_x, max_x, ImGuiCond_Always);
+      // Pick up the follow window changes made above
+      update_limits();
+      ImPlot::SetNextAxisLimits(ImAxis_X1, min_x_, max_x_, ImGuiCond_Always);
    }
 
    next();
@@ -199,6 +649,52 @@ void data::draw_settings() {
       ImGui::TextColored({1.0f, 0.0f, 0.0f, 1.0f}, "%s",
                          error_message_.c_str());
    }
+
+   auto dropped = dropped_;
+   for (const auto &p : producers_) {
+      dropped += p->dropped();
+   }
+
+   if (dropped) {
+      ImGui::TextColored({1.0f, 0.0f, 0.0f, 1.0f},
+                         "Dropped samples: %llu (UI is too slow)",
+                         static_cast<unsigned long long>(dropped));
+   }
+
+   if (spill_) {
+      constexpr double mib = 1024.0 * 1024.0;
+      ImGui::Text("Spilled to disk: %.1f MiB (file: %.1f MiB)",
+                  static_cast<double>(spill_->used()) / mib,
+                  static_cast<double>(spill_->size()) / mib);
+   }
+
+   if (opts_.compress_history) {
+      draw_compression();
+   }
+}
+
+void data::draw_compression() {
+   if (!ImGui::TreeNode("Compression")) {
+      return;
+   }
+
+   constexpr double kib = 1024.0;
+   for (channel_id_t id = 0; id < plot_data_.size(); ++id) {
+      const auto stats = plot_data_.compression(id);
+      if (!stats.unpacked_bytes) {
+         continue;
+      }
+
+      const auto saved = stats.unpacked_bytes - stats.packed_bytes;
+      ImGui::Text("%s: %.1f KiB saved (%.1fx)",
+                  plot_data_.name(id).c_str(),
+                  static_cast<double>(saved) / kib,
+                  static_cast<double>(stats.unpacked_bytes) /
+                      static_cast<double>(std::max<std::uint64_t>(
+                          stats.packed_bytes, 1)));
+   }
+
+   ImGui::TreePop();
 }
 
 void data::update_limits() {
@@ -207,46 +703,129 @@ void data::update_limits() {
    // Axis flags
    x_axis_flags_ = ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_NoLabel;
    y_axis_flags_ = ImPlotAxisFlags_NoLabel;
-   if (opts_.follow) {
-      y_axis_flags_ |= (ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit);
+
+   if (opts_.time_axis) {
+      x_axis_flags_ = ImPlotAxisFlags_NoLabel;
    }
 
-   if (opts_.follow) {
-      int max_entries = [&]() {
-         std::size_t result = 0;
-         for (const auto &kv : plot_data_) {
-            result = std::max(kv.second.size(), result);
-         }
-         return static_cast<int>(result);
-      }();
+   if (!opts_.follow) {
+      plot_data_.set_window({});
+      has_y_limits_ = false;
+      return;
+   }
+
+   channel_store::window window;
+   if (opts_.time_axis) {
+      using namespace std::chrono;
+      const auto seconds = std::max(opts_.follow_seconds, 0.001);
+      window.age = duration_cast<channel_store::clock_t::duration>(
+          duration<double>(seconds));
+
+      max_x_ = plot_data_.size() ? plot_data_.seconds(plot_data_.latest()) : 0;
+      min_x_ = max_x_ - seconds;
+   } else {
+      // X axis is the absolute sample index, dropped samples don't shift it
+      window.samples =
+          static_cast<std::uint64_t>(std::max(opts_.follow_window, 1));
+
+      const auto max_entries = plot_data_.end_index();
+      max_x_ = static_cast<double>(max_entries);
+      min_x_ = static_cast<double>(
+          max_entries < window.samples ? 0 : max_entries - window.samples);
+   }
 
-      max_x_ = max_entries;
-      if (max_entries < opts_.follow_window) {
-         min_x_ = 0;
+   // Value range of the window is tracked as samples arrive, so there is no
+   // need to let ImPlot fit the Y axis over all visible points
+   plot_data_.set_window(window);
+   has_y_limits_ = false;
+   for (channel_id_t id = 0; id < plot_data_.size(); ++id) {
+      auto visible = graph_verdicts_.get(
+          id, [&] { return graph_filter_.matches(plot_data_.name(id)); });
+      if (!visible) {
+         continue;
+      }
+
+      auto range = plot_data_.window_range(id);
+      if (!range) {
+         continue;
+      }
+
+      if (!has_y_limits_) {
+         min_y_ = range->first;
+         max_y_ = range->second;
+         has_y_limits_ = true;
       } else {
-         min_x_ = max_entries - opts_.follow_window;
+         min_y_ = std::min<double>(min_y_, range->first);
+         max_y_ = std::max<double>(max_y_, range->second);
       }
    }
+
+   if (has_y_limits_ && min_y_ == max_y_) {
+      min_y_ -= 0.5;
+      max_y_ += 0.5;
+   }
 }
 
 void data::draw_plot() {
+   const auto timer = profiler_->measure(ui::frame_stage::plot);
+
    if (opts_.follow) {
       ImPlot::SetNextAxisLimits(ImAxis_X1, min_x_, max_x_, ImGuiCond_Always);
+      if (has_y_limits_) {
+         ImPlot::SetNextAxisLimits(ImAxis_Y1, min_y_, max_y_,
+                                   ImGuiCond_Always);
+      }
    }
 
    if (ImPlot::BeginPlot("Data", {-1, -1}, plot_flags_)) {
-      ImPlot::SetupAxis(ImAxis_X1, "Time", x_axis_flags_);
+      ImPlot::SetupAxis(ImAxis_X1, opts_.time_axis ? "Time, s" : "Sample",
+                        x_axis_flags_);
       ImPlot::SetupAxis(ImAxis_Y1, "Value", y_axis_flags_);
 
-      for (const auto &kv : plot_data_) {
-         const auto &name = kv.first;
-         const auto &values = kv.second;
-         if (!std::regex_match(name, graph_regex_)) {
+      // Submit everything when the X axis is being fit, otherwise only the
+      // visible part of every channel
+      const auto limits = ImPlot::GetPlotLimits();
+      const auto width = static_cast<double>(ImPlot::GetPlotSize().x);
+      const bool fit_x = ImPlot::GetCurrentPlot()->Axes[ImAxis_X1].FitThisFrame;
+
+      for (channel_id_t id = 0; id < plot_data_.size(); ++id) {
+         const auto &name = plot_data_.name(id);
+         if (plot_data_.times(id).empty()) {
             continue;
          }
 
-         ImPlot::PlotLine(name.c_str(), values.data(),
-                          static_cast<int>(values.size()));
+         auto visible = graph_verdicts_.get(
+             id, [&] { return graph_filter_.matches(name); });
+         if (!visible) {
+            continue;
+         }
+
+         const channel_view view{
+             &plot_data_, id,
+             opts_.time_axis ? &plot_data_.times(id) : nullptr};
+
+         if (fit_x) {
+            // Fitting needs the points to go through ImPlot
+            constexpr auto inf = std::numeric_limits<double>::infinity();
+            plot_channel(name, view, plot_data_.lod(id), -inf, inf, width);
+            continue;
+         }
+
+         gpu_line gpu{line_renderer_, nullptr, &line_staging_};
+         if (line_renderer_) {
+            if (id >= gpu_series_.size()) {
+               gpu_series_.resize(id + 1);
+            }
+
+            auto &series = gpu_series_[id];
+            if (!series.buffer) {
+               series.buffer = std::make_unique<render::line_buffer>();
+            }
+            gpu.series = &series;
+         }
+
+         plot_channel(name, view, plot_data_.lod(id), limits.X.Min,
+                      limits.X.Max, width, line_renderer_ ? &gpu : nullptr);
       }
 
       if (draw_plot_cb_) {
@@ -255,4 +834,9 @@ void data::draw_plot() {
 
       ImPlot::EndPlot();
    }
+
+   if (has_undrawn_) {
+      latency_->frame_drawn(oldest_undrawn_);
+      has_undrawn_ = false;
+   }
 }
@@ -0,0 +1,53 @@
+/**
+ * @file   framer.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/framer.h>
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace asp::inputs;
+
+framer::framer(std::string separator)
+   : separator_{std::move(separator)} {
+   if (separator_.empty()) {
+      throw std::runtime_error("Empty line separator");
+   }
+
+   carry_.reserve(256);
+}
+
+std::size_t framer::find(std::string_view where, std::size_t from) const {
+   // memchr() is vectorized by every libc we care about, so look for the first
+   // separator character with it and only compare the rest on a hit.
+   const auto first = separator_.front();
+   const auto sep_size = separator_.size();
+
+   const char *begin = where.data();
+   const char *end = begin + where.size();
+   const char *it = begin + from;
+
+   while (it < end) {
+      auto hit = static_cast<const char *>(
+          std::memchr(it, first, static_cast<std::size_t>(end - it)));
+      if (hit == nullptr) {
+         return npos;
+      }
+
+      if (static_cast<std::size_t>(end - hit) < sep_size) {
+         // Partial separator at the very end
+         return npos;
+      }
+
+      if (std::memcmp(hit + 1, separator_.data() + 1, sep_size - 1) == 0) {
+         return static_cast<std::size_t>(hit - begin);
+      }
+
+      it = hit + 1;
+   }
+
+   return npos;
+}
@@ -0,0 +1,322 @@
+/**
+ * @file   importer.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/data.h>
+#include <asp/inputs/importer.h>
+#include <asp/inputs/parser.h>
+#include <asp/options.h>
+#include <asp/ui/logs.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+using namespace asp::inputs;
+
+namespace bip = boost::interprocess;
+
+namespace {
+
+//! Approximate chunk size, chunks always end at a line boundary
+constexpr std::size_t chunk_size = 1 << 20;
+
+//! Number of parsed chunks the workers can get ahead of the merging, bounds
+//! the memory held by the parsed, but not yet merged results
+constexpr std::size_t chunks_ahead_per_worker = 4;
+
+//! Time the UI thread is allowed to spend merging chunks per frame
+constexpr auto merge_budget = std::chrono::milliseconds(8);
+
+//! Samples merged between checking the merge budget
+constexpr std::size_t merge_batch = 4096;
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: importer::options
+////////////////////////////////////////////////////////////////////////////////
+asp::po_desc_t importer::options::prepare() {
+   namespace po = boost::program_options;
+
+   po::options_description od("Import Options");
+
+   // clang-format off
+   od.add_options()
+       ("open,o", po::value<std::string>()->default_value(""),
+        "Import a previously recorded log file, with one name:value(,name:value)* line per entry")
+       ("import-threads", po::value<int>()->default_value(0),
+        "Number of threads parsing the imported file (0 - one per core)")
+       ("import-period-ms", po::value<double>()->default_value(1.0),
+        "Time between the imported lines on the time axis, in milliseconds")
+       ;
+   // clang-format on
+
+   return od;
+}
+
+importer::options importer::options::load(po_vars_t &vm) {
+   importer::options opts;
+   opts.file = vm["open"].as<std::string>();
+   opts.threads = vm["import-threads"].as<int>();
+
+   using namespace std::chrono;
+   const auto period = vm["import-period-ms"].as<double>();
+   if (period <= 0) {
+      throw boost::program_options::error("Invalid import period");
+   }
+   opts.line_period = duration_cast<steady_clock::duration>(
+       duration<double, std::milli>(period));
+   return opts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: importer
+////////////////////////////////////////////////////////////////////////////////
+importer::importer(const asp::options &opts, data &data, ui::logs &logs)
+   : opts_{opts.importer}
+   , data_{&data}
+   , logs_{&logs}
+   , separator_{opts.serial.line_separator}
+   , name_filter_{opts.data.name_filter} {
+   if (separator_.empty()) {
+      separator_ = "\n";
+   }
+}
+
+importer::~importer() {
+   {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stop_ = true;
+   }
+   merged_cv_.notify_all();
+
+   for (auto &worker : workers_) {
+      worker.join();
+   }
+}
+
+void importer::start() {
+   if (opts_.file.empty()) {
+      return;
+   }
+
+   try {
+      mapping_ = std::make_unique<bip::file_mapping>(opts_.file.c_str(),
+                                                     bip::read_only);
+      region_ = bip::mapped_region{*mapping_, bip::read_only};
+   } catch (const std::exception &e) {
+      logs_->add("Unable to open {}: {}", opts_.file, e.what());
+      return;
+   }
+
+   split({static_cast<const char *>(region_.get_address()),
+          region_.get_size()});
+
+   auto threads = static_cast<std::size_t>(std::max(opts_.threads, 0));
+   if (threads == 0) {
+      threads = std::max(std::thread::hardware_concurrency(), 1U);
+   }
+   threads = std::min(threads, chunks_.size());
+
+   logs_->add("Importing {}: {} bytes, {} chunks, {} threads", opts_.file,
+              region_.get_size(), chunks_.size(), threads);
+
+   max_ahead_ = threads * chunks_ahead_per_worker;
+   started_ = std::chrono::steady_clock::now();
+   for (std::size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { work(); });
+   }
+}
+
+void importer::split(std::string_view text) {
+   while (!text.empty()) {
+      auto end = text.size();
+      if (end > chunk_size) {
+         const auto pos = text.find(separator_, chunk_size);
+         if (pos != std::string_view::npos) {
+            end = pos + separator_.size();
+         }
+      }
+
+      chunks_.push_back(chunk{text.substr(0, end)});
+      text.remove_prefix(end);
+   }
+}
+
+void importer::work() {
+   while (true) {
+      const auto idx = next_.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= chunks_.size()) {
+         return;
+      }
+
+      {
+         std::unique_lock<std::mutex> lock{mutex_};
+         merged_cv_.wait(lock,
+                         [&] { return stop_ || idx < merged_ + max_ahead_; });
+         if (stop_) {
+            return;
+         }
+      }
+
+      auto parsed = parse(chunks_[idx].text);
+
+      {
+         std::lock_guard<std::mutex> lock{mutex_};
+         chunks_[idx].parsed = std::move(parsed);
+      }
+
+      if (notify_) {
+         notify_();
+      }
+   }
+}
+
+std::unique_ptr<importer::result> importer::parse(std::string_view text) const {
+   auto parsed = std::make_unique<result>();
+
+   channel_registry channels;
+   filter_verdicts verdicts;
+   channel_id_t id;
+
+   auto filter = [&](std::string_view name) {
+      id = channels.intern(name).first;
+      return verdicts.get(id, [&] { return name_filter_.matches(name); });
+   };
+
+   auto on_value = [&](std::string_view, const number &value) {
+      parsed->samples.push_back(
+          {id, static_cast<std::uint32_t>(parsed->lines), value});
+   };
+
+   auto on_error = [&](std::string_view, parse_error) { ++parsed->errors; };
+
+   while (!text.empty()) {
+      const auto end = text.find(separator_);
+      const auto line = text.substr(0, end);
+      text.remove_prefix(end == std::string_view::npos
+                             ? text.size()
+                             : end + separator_.size());
+
+      if (line.empty()) {
+         continue;
+      }
+
+      parse_line(line, filter, on_value, on_error);
+      ++parsed->lines;
+   }
+
+   parsed->names.reserve(channels.size());
+   for (channel_id_t i = 0; i < channels.size(); ++i) {
+      parsed->names.push_back(channels.name(i));
+   }
+   return parsed;
+}
+
+bool importer::drain() {
+   const auto deadline = std::chrono::steady_clock::now() + merge_budget;
+   bool merged = false;
+
+   while (!done()) {
+      if (!merging_) {
+         {
+            std::lock_guard<std::mutex> lock{mutex_};
+            merging_ = std::move(chunks_[merged_].parsed);
+         }
+
+         if (!merging_) {
+            break;
+         }
+
+         auto &store = data_->get_plot_data();
+         channel_map_.clear();
+         for (const auto &name : merging_->names) {
+            channel_map_.push_back(store.intern(name));
+         }
+         merge_pos_ = 0;
+      }
+
+      merged = true;
+      if (!merge(*merging_, deadline)) {
+         // Out of budget, the rest of the chunk goes into the next frames
+         break;
+      }
+
+      merging_.reset();
+      bytes_merged_ += chunks_[merged_].text.size();
+
+      {
+         std::lock_guard<std::mutex> lock{mutex_};
+         ++merged_;
+      }
+      merged_cv_.notify_all();
+
+      if (done()) {
+         elapsed_ = std::chrono::steady_clock::now() - started_;
+         logs_->add("Imported {}: {} lines, {} errors", opts_.file, lines_,
+                    errors_);
+      }
+
+      if (std::chrono::steady_clock::now() > deadline) {
+         break;
+      }
+   }
+
+   return merged;
+}
+
+bool importer::merge(const result &parsed,
+                     std::chrono::steady_clock::time_point deadline) {
+   auto &store = data_->get_plot_data();
+   const auto &samples = parsed.samples;
+
+   while (merge_pos_ < samples.size()) {
+      const auto end = std::min(samples.size(), merge_pos_ + merge_batch);
+      for (; merge_pos_ < end; ++merge_pos_) {
+         const auto &s = samples[merge_pos_];
+         store.append(channel_map_[s.id], s.value, line_time(lines_ + s.line));
+      }
+
+      if (merge_pos_ < samples.size() &&
+          std::chrono::steady_clock::now() > deadline) {
+         return false;
+      }
+   }
+
+   lines_ += parsed.lines;
+   errors_ += parsed.errors;
+   return true;
+}
+
+std::chrono::steady_clock::time_point
+importer::line_time(std::uint64_t line) const {
+   // The file carries no host timestamps, lines are placed at a fixed period
+   // after the import start
+   return started_ +
+          opts_.line_period * static_cast<std::chrono::steady_clock::rep>(line);
+}
+
+void importer::draw() {
+   if (chunks_.empty()) {
+      return;
+   }
+
+   if (!ImGui::CollapsingHeader("Import")) {
+      return;
+   }
+
+   ImGui::TextUnformatted(opts_.file.c_str());
+
+   const auto total = static_cast<double>(region_.get_size());
+   ImGui::ProgressBar(static_cast<float>(bytes_merged_ / total));
+
+   ImGui::Text("Lines: %llu", static_cast<unsigned long long>(lines_));
+   ImGui::Text("Errors: %llu", static_cast<unsigned long long>(errors_));
+
+   using namespace std::chrono;
+   const auto elapsed = done() ? elapsed_ : steady_clock::now() - started_;
+   ImGui::Text("Elapsed: %.2f s", duration<double>(elapsed).count());
+}
@@ -0,0 +1,102 @@
+/**
+ * @file   lod_pyramid.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/lod_pyramid.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace asp::inputs;
+
+namespace {
+
+void merge(lod_pyramid::level_t &level, std::uint64_t idx,
+           const lod_pyramid::bucket &value) {
+   if (level.empty()) {
+      level.reset(idx);
+   }
+
+   if (idx >= level.end_index()) {
+      level.push_back(value);
+      return;
+   }
+
+   // NaN samples are skipped, std::min / std::max would keep a leading NaN
+   // for the whole bucket. A bucket stays NaN only if all its samples are
+   auto &last = level.back();
+   if (std::isnan(last.min) || value.min < last.min) {
+      last.min = value.min;
+   }
+   if (std::isnan(last.max) || value.max > last.max) {
+      last.max = value.max;
+   }
+   last.last = value.last;
+}
+
+} // namespace
+
+void lod_pyramid::append(std::uint64_t index, float value,
+                         time_point received) {
+   if (levels_.empty()) {
+      levels_.emplace_back();
+      if (spill_) {
+         levels_.back().set_spill(*spill_, hot_chunks_);
+      }
+   }
+
+   for (std::size_t k = 0; k < levels_.size(); ++k) {
+      merge(levels_[k], index >> (base_shift + level_shift * k),
+            {value, value, received, received});
+   }
+
+   if (levels_.back().size() >= max_top_buckets) {
+      add_level();
+   }
+}
+
+void lod_pyramid::trim(std::uint64_t first_index) {
+   for (std::size_t k = 0; k < levels_.size(); ++k) {
+      auto &level = levels_[k];
+      const auto first = first_index >> (base_shift + level_shift * k);
+      if (first > level.first_index()) {
+         level.drop_front(first - level.first_index());
+      }
+   }
+}
+
+void lod_pyramid::set_spill(spill_file &file, std::size_t hot_samples) {
+   spill_ = &file;
+   hot_chunks_ = (hot_samples >> base_shift) / level_t::chunk_size;
+   for (auto &level : levels_) {
+      level.set_spill(file, hot_chunks_);
+   }
+}
+
+std::size_t lod_pyramid::pick_level(double samples_per_pixel) const {
+   std::size_t result = levels_.size();
+   for (std::size_t k = 0; k < levels_.size(); ++k) {
+      if (static_cast<double>(span(k)) > samples_per_pixel) {
+         break;
+      }
+      result = k;
+   }
+   return result;
+}
+
+void lod_pyramid::add_level() {
+   const auto &prev = levels_.back();
+
+   level_t level;
+   if (spill_) {
+      level.set_spill(*spill_, hot_chunks_);
+   }
+
+   for (std::size_t i = 0; i < prev.size(); ++i) {
+      merge(level, (prev.first_index() + i) >> level_shift, prev[i]);
+   }
+
+   levels_.push_back(std::move(level));
+}
@@ -0,0 +1,107 @@
+/**
+ * @file   name_filter.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/name_filter.h>
+
+using namespace asp::inputs;
+
+namespace {
+
+bool is_literal(std::string_view text) {
+   return text.find_first_of("\\.^$|()[]{}*+?") == std::string_view::npos;
+}
+
+bool starts_with(std::string_view what, std::string_view with) {
+   return what.size() >= with.size() && what.substr(0, with.size()) == with;
+}
+
+bool ends_with(std::string_view what, std::string_view with) {
+   return what.size() >= with.size() &&
+          what.substr(what.size() - with.size()) == with;
+}
+
+} // namespace
+
+name_filter::name_filter(const std::string &pattern) {
+   if (!parse_trivial(pattern)) {
+      kind_ = kind::regex;
+      regex_.assign(pattern);
+   }
+}
+
+bool name_filter::parse_trivial(std::string_view pattern) {
+   // Anchors are implied by regex_match
+   if (starts_with(pattern, "^")) {
+      pattern.remove_prefix(1);
+   }
+
+   if (ends_with(pattern, "$") && !ends_with(pattern, "\\$")) {
+      pattern.remove_suffix(1);
+   }
+
+   if (pattern == ".*") {
+      kind_ = kind::all;
+      return true;
+   }
+
+   if (ends_with(pattern, ".*")) {
+      auto prefix = pattern.substr(0, pattern.size() - 2);
+      if (!is_literal(prefix)) {
+         return false;
+      }
+
+      kind_ = kind::prefix;
+      literals_.emplace_back(prefix);
+      return true;
+   }
+
+   if (starts_with(pattern, "(") && ends_with(pattern, ")")) {
+      pattern = pattern.substr(1, pattern.size() - 2);
+   }
+
+   // a|b|c
+   std::vector<std::string> literals;
+   while (true) {
+      const auto end = pattern.find('|');
+      const auto literal = pattern.substr(0, end);
+      if (!is_literal(literal)) {
+         return false;
+      }
+
+      literals.emplace_back(literal);
+      if (end == std::string_view::npos) {
+         break;
+      }
+      pattern.remove_prefix(end + 1);
+   }
+
+   kind_ = kind::literals;
+   literals_ = std::move(literals);
+   return true;
+}
+
+bool name_filter::matches(std::string_view name) const {
+   switch (kind_) {
+      case kind::all:
+         return true;
+
+      case kind::prefix:
+         return starts_with(name, literals_.front());
+
+      case kind::literals:
+         for (const auto &literal : literals_) {
+            if (name == literal) {
+               return true;
+            }
+         }
+         return false;
+
+      case kind::regex:
+         break;
+   }
+
+   return std::regex_match(name.begin(), name.end(), regex_);
+}
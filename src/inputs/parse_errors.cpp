@@ -0,0 +1,117 @@
+/**
+ * @file   parse_errors.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/parse_errors.h>
+#include <asp/ui/logs.h>
+
+#include <cmath>
+#include <utility>
+
+using namespace asp::inputs;
+
+namespace {
+
+//! Longer sample lines are cut, over-long lines would flood the log otherwise
+constexpr std::size_t max_sample_size = 128;
+
+//! Errors are summed up for that long, starting with the first one
+constexpr auto flush_delay = std::chrono::seconds(1);
+
+const char *describe(parse_error ec) {
+   switch (ec) {
+      case parse_error::bad_number:
+         return "invalid values";
+
+      case parse_error::out_of_range:
+         return "out of range values";
+
+      case parse_error::missing_separator:
+         return "fields without ':'";
+
+      case parse_error::missing_name:
+         return "fields without a channel name";
+
+      case parse_error::line_too_long:
+         return "over-long lines";
+
+      default:
+         return to_string(ec);
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: parse_errors
+////////////////////////////////////////////////////////////////////////////////
+parse_errors::parse_errors(boost::asio::io_context &ctx, ui::logs &logs,
+                           name_fn name_of)
+   : logs_{&logs}
+   , name_of_{std::move(name_of)}
+   , timer_{ctx} {
+   // Nothing to do here
+}
+
+void parse_errors::record(parse_error ec, channel_id_t channel,
+                          std::string_view line) {
+   const auto idx = static_cast<std::size_t>(channel_id_t(channel + 1)) * kinds +
+                    static_cast<std::size_t>(ec);
+   if (idx >= counters_.size()) {
+      counters_.resize(idx + 1);
+   }
+
+   if (!pending_) {
+      pending_ = true;
+      first_ = clock_t::now();
+
+      timer_.expires_at(first_ + flush_delay);
+      timer_.async_wait([this](auto error) {
+         if (error != boost::asio::error::operation_aborted) {
+            flush();
+         }
+      });
+   }
+
+   // Only the first line is kept, the sample string keeps its capacity
+   auto &c = counters_[idx];
+   if (c.count++ == 0) {
+      c.sample.assign(line.substr(0, max_sample_size));
+   }
+   ++total_;
+}
+
+void parse_errors::flush() {
+   // Actual interval, the timer might fire late on a busy I/O context
+   using seconds_t = std::chrono::duration<double>;
+   const auto seconds = std::round(
+       seconds_t(clock_t::now() - first_).count() * 10.0) / 10.0;
+
+   for (std::size_t i = 0; i < counters_.size(); ++i) {
+      auto &c = counters_[i];
+      if (!c.count) {
+         continue;
+      }
+
+      const auto channel = static_cast<channel_id_t>(i / kinds) - 1;
+      const auto ec = static_cast<parse_error>(i % kinds);
+      report(ec, channel == no_channel ? std::string_view{} : name_of_(channel),
+             c, seconds);
+      c.count = 0;
+   }
+   pending_ = false;
+}
+
+void parse_errors::report(parse_error ec, std::string_view channel,
+                          const counter &c, double seconds) {
+   const auto cut = c.sample.size() == max_sample_size ? "..." : "";
+   if (channel.empty()) {
+      logs_->add("{} {} in the last {} s, e.g.: {}{}", c.count, describe(ec),
+                 seconds, c.sample, cut);
+   } else {
+      logs_->add("{} {} on '{}' in the last {} s, e.g.: {}{}", c.count,
+                 describe(ec), channel, seconds, c.sample, cut);
+   }
+}
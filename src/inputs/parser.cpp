@@ -0,0 +1,157 @@
+/**
+ * @file   parser.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/parser.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+using namespace asp::inputs;
+
+namespace {
+
+bool is_space(char ch) {
+   return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' ||
+          ch == '\f';
+}
+
+//! Drop the surrounding whitespace and an explicit plus sign, which
+//! std::from_chars doesn't accept
+std::string_view trim(std::string_view text) {
+   while (!text.empty() && is_space(text.front())) {
+      text.remove_prefix(1);
+   }
+
+   while (!text.empty() && is_space(text.back())) {
+      text.remove_suffix(1);
+   }
+
+   if (!text.empty() && text.front() == '+') {
+      text.remove_prefix(1);
+   }
+   return text;
+}
+
+//! Split off the sign and the "0x" prefix, std::from_chars takes hexadecimal
+//! digits without either of them
+bool strip_hex_prefix(std::string_view &digits, bool &negative) {
+   auto rest = digits;
+   const bool minus = !rest.empty() && rest.front() == '-';
+   if (minus) {
+      rest.remove_prefix(1);
+   }
+
+   const bool prefix =
+       rest.size() > 2 && rest[0] == '0' && (rest[1] == 'x' || rest[1] == 'X');
+   if (!prefix || rest[2] == '-' || rest[2] == '+') {
+      return false;
+   }
+
+   digits = rest.substr(2);
+   negative = minus;
+   return true;
+}
+
+} // namespace
+
+const char *asp::inputs::to_string(parse_error ec) {
+   switch (ec) {
+      case parse_error::none:
+         return "no error";
+
+      case parse_error::bad_number:
+         return "not a number";
+
+      case parse_error::out_of_range:
+         return "value out of range";
+
+      case parse_error::missing_separator:
+         return "missing ':'";
+
+      case parse_error::missing_name:
+         return "missing channel name";
+
+      case parse_error::line_too_long:
+         return "line too long";
+   }
+
+   return "unknown error";
+}
+
+parse_error asp::inputs::parse_value(std::string_view text, float &value) {
+   text = trim(text);
+
+#if defined(__cpp_lib_to_chars)
+   auto digits = text;
+   bool negative = false;
+   const bool hex = strip_hex_prefix(digits, negative);
+
+   const auto end = digits.data() + digits.size();
+   const auto res = hex ? std::from_chars(digits.data(), end, value,
+                                          std::chars_format::hex)
+                        : std::from_chars(digits.data(), end, value);
+   if (res.ec == std::errc::result_out_of_range) {
+      return parse_error::out_of_range;
+   }
+
+   if (res.ec != std::errc{} || res.ptr != end) {
+      return parse_error::bad_number;
+   }
+
+   if (negative) {
+      value = -value;
+   }
+#else
+   // Floating point std::from_chars is missing from older standard libraries
+   // (e.g. libc++ before macOS 13.3), fall back to strtof on a stack copy.
+   // strtof handles the hexadecimal values on its own.
+   char buffer[64];
+   if (text.size() >= sizeof(buffer)) {
+      return parse_error::bad_number;
+   }
+   std::memcpy(buffer, text.data(), text.size());
+   buffer[text.size()] = '\0';
+
+   char *end;
+   errno = 0;
+   value = std::strtof(buffer, &end);
+   if (end == buffer || end != buffer + text.size()) {
+      return parse_error::bad_number;
+   }
+
+   if (errno == ERANGE) {
+      return parse_error::out_of_range;
+   }
+#endif
+
+   return parse_error::none;
+}
+
+parse_error asp::inputs::parse_value(std::string_view text, number &value) {
+   auto digits = trim(text);
+   bool negative = false;
+   const bool hex = strip_hex_prefix(digits, negative);
+
+   const auto end = digits.data() + digits.size();
+   const auto res = std::from_chars(digits.data(), end, value.integer,
+                                    hex ? 16 : 10);
+
+   // Anything continuing as a float (fraction, exponent) is parsed as one,
+   // so are the integers out of the 64-bit range
+   if (res.ec == std::errc{} && res.ptr == end) {
+      value.is_integer = true;
+      if (negative) {
+         value.integer = -value.integer;
+      }
+      return parse_error::none;
+   }
+
+   value.is_integer = false;
+   return parse_value(text, value.real);
+}
@@ -0,0 +1,33 @@
+/**
+ * @file   producer.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/producer.h>
+
+using namespace asp::inputs;
+
+bool producer::push(channel_id_t id, const number &value,
+                    clock_t::time_point received) {
+   if (id >= announced_.size()) {
+      announced_.resize(id + 1, false);
+   }
+
+   const bool announce = !announced_[id];
+   const sample s{id, announce ? &channels_.name(id) : nullptr, value,
+                  received};
+
+   // Never block, drop the samples if the UI can't keep up
+   if (!samples_.push(s)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   announced_[id] = true;
+
+   if (notify_ && !pending_.exchange(true)) {
+      notify_();
+   }
+   return true;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file   receive_buffer.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/receive_buffer.h>
+
+#include <algorithm>
+
+using namespace asp::inputs;
+
+receive_buffer::receive_buffer(std::size_t initial_capacity,
+                               std::size_t max_capacity)
+   : storage_(std::max<std::size_t>(initial_capacity, 1))
+   , max_capacity_{std::max(max_capacity, storage_.size())} {
+   // Nothing to do here
+}
+
+boost::asio::mutable_buffer receive_buffer::prepare() {
+   if (empty()) {
+      // Only resize while nothing is pending, data() views stay intact
+      // otherwise
+      if (saturated_ >= saturation_threshold &&
+          storage_.size() < max_capacity_) {
+         storage_.resize(std::min(storage_.size() * 2, max_capacity_));
+         saturated_ = 0;
+         ++stats_.grows;
+      }
+
+      head_ = tail_ = 0;
+   }
+
+   requested_ = free_space();
+   return boost::asio::buffer(storage_.data() + head_, requested_);
+}
+
+void receive_buffer::commit(std::size_t bytes) {
+   head_ += bytes;
+
+   if (bytes == requested_) {
+      ++saturated_;
+   } else {
+      saturated_ = 0;
+   }
+
+   ++stats_.completions;
+   stats_.bytes += bytes;
+   stats_.last_completion = bytes;
+   stats_.max_completion = std::max(stats_.max_completion, bytes);
+}
+
+void receive_buffer::consume() {
+   tail_ = head_;
+   ++stats_.flushes;
+}
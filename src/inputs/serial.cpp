@@ -4,20 +4,58 @@
  * @date   Aug. 21, 2021
  */
 
+#include <asp/config.h>
 #include <asp/inputs/serial.h>
 #include <asp/options.h>
 #include <asp/types.h>
+#include <asp/ui/latency.h>
 #include <asp/ui/logs.h>
 #include <asp/ui/std_input_text.h>
 
 #include <imgui.h>
 
+#include <mutex>
 #include <vector>
 
+#if ASP_TARGET_OS(WINDOWS)
+#include <windows.h>
+#elif ASP_TARGET_OS(UNIX) || ASP_TARGET_OS(APPLE)
+#include <sys/ioctl.h>
+#endif
+
 using namespace asp::inputs;
 
 namespace asio = boost::asio;
 
+namespace {
+
+//! Smaller receive buffers are enlarged: a quarter of the buffer is always
+//! left free for the next read, which has to be at least one byte
+constexpr std::size_t min_read_buffer = 64;
+
+//! Number of bytes received by the driver, but not yet read
+std::size_t input_queue_size(asio::serial_port &port) {
+#if ASP_TARGET_OS(WINDOWS)
+   DWORD errors = 0;
+   COMSTAT stat{};
+   if (ClearCommError(port.native_handle(), &errors, &stat)) {
+      return stat.cbInQue;
+   }
+   return 0;
+#elif ASP_TARGET_OS(UNIX) || ASP_TARGET_OS(APPLE)
+   int bytes = 0;
+   if (ioctl(port.native_handle(), FIONREAD, &bytes) == 0 && bytes > 0) {
+      return static_cast<std::size_t>(bytes);
+   }
+   return 0;
+#else
+   (void)port;
+   return 0;
+#endif
+}
+
+} // namespace
+
 class serial::line_separator_picker {
 public:
    asp::result_t<void> set_selection(const std::string &separator) {
@@ -80,17 +118,6 @@ private:
    int current_selection_{0};
 };
 
-bool ends_with(const std::string &what, const std::string &with) {
-   if (with.length() > what.length()) {
-      return false;
-   }
-
-   auto m =
-       std::mismatch(with.rbegin(), with.rend(), what.rbegin(), what.rend());
-
-   return m.first == with.rend();
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Class: options
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +135,23 @@ asp::po_desc_t serial::options::prepare() {
             "Line separator, one of nl, cr, nlcr, crnl. Where nl - is the new "
             "line character ('\\n'), and cr - is the carriage return "
             "character ('\\r') ")
+       ("read-buffer", po::value<std::size_t>()->default_value(256),
+            "Initial receive buffer size in bytes (at least 64)")
+       ("max-read-buffer", po::value<std::size_t>()->default_value(64 * 1024),
+            "Receive buffer size limit in bytes. The buffer grows up to this "
+            "size while reads keep filling it completely")
+       ("coalesce-bytes", po::value<std::size_t>()->default_value(0),
+            "Combine reads until this many bytes are received (0 - a quarter "
+            "of the receive buffer). Has no effect without --coalesce-us")
+       ("coalesce-us", po::value<int>()->default_value(0),
+            "Combine reads for up to this many microseconds before parsing "
+            "them (0 - parse every read right away)")
+       ("ingest-thread",
+            "Read and parse the serial data on a dedicated thread, "
+            "independently of the UI frame rate")
+       ("ingest-cpu", po::value<int>()->default_value(-1),
+            "Pin the ingest thread to this CPU core (-1 - no pinning). Has no "
+            "effect without --ingest-thread")
        ;
    // clang-format on
 
@@ -137,6 +181,19 @@ serial::options serial::options::load(po_vars_t &vm) {
                                           opts.line_separator);
    }
 
+   opts.read_buffer = vm["read-buffer"].as<std::size_t>();
+   opts.max_read_buffer = vm["max-read-buffer"].as<std::size_t>();
+   opts.coalesce_bytes = vm["coalesce-bytes"].as<std::size_t>();
+   opts.coalesce_us = vm["coalesce-us"].as<int>();
+   if (opts.read_buffer == 0 || opts.max_read_buffer < opts.read_buffer) {
+      throw boost::program_options::error("Invalid receive buffer size");
+   }
+   opts.read_buffer = std::max(opts.read_buffer, min_read_buffer);
+   opts.max_read_buffer = std::max(opts.max_read_buffer, min_read_buffer);
+
+   opts.ingest_thread = vm.count("ingest-thread") != 0;
+   opts.ingest_cpu = vm["ingest-cpu"].as<int>();
+
    return opts;
 }
 
@@ -146,11 +203,17 @@ serial::options serial::options::load(po_vars_t &vm) {
 serial::serial(boost::asio::io_context &ctx,
                const asp::options &opts,
                data &data,
-               ui::logs &logs)
+               ui::logs &logs,
+               ui::latency_tracker &latency)
    : opts_{opts.serial}
+   , ui_opts_{opts.serial}
    , data_{&data}
    , serial_{ctx}
+   , flush_timer_{ctx}
    , logs_{&logs}
+   , latency_{&latency}
+   , buffer_{opts_.read_buffer, opts_.max_read_buffer}
+   , framer_{opts_.line_separator}
    , line_separator_picker_{new line_separator_picker}
    , baud_rate_picker_{new baud_rate_picker} {
    using namespace std::string_literals;
@@ -169,19 +232,37 @@ serial::serial(boost::asio::io_context &ctx,
 serial::~serial() = default;
 
 void serial::set_error(const std::string &err) {
-   logs_->add("Serial port error: ", err);
-   status_ = err;
-   collapsed_ = false;
+   logs_->add("Serial port error: {}", err);
+
+   std::lock_guard<std::mutex> lock{state_mutex_};
+   state_.status = err;
+   state_.expand = true;
+}
+
+void serial::set_connected(bool connected) {
+   std::lock_guard<std::mutex> lock{state_mutex_};
+   state_.connected = connected;
+   if (connected) {
+      state_.status.clear();
+      state_.expand = true;
+   }
 }
 
 void serial::start() {
-   status_ = "Opening...";
+   asio::post(serial_.get_executor(), [this] { open(); });
+}
+
+void serial::open() {
+   {
+      std::lock_guard<std::mutex> lock{state_mutex_};
+      state_.status = "Opening...";
+   }
 
    boost::system::error_code ec;
    serial_.open(opts_.port, ec);
    if (ec) {
       set_error(ec.message());
-      connected_ = false;
+      set_connected(false);
       return;
    }
 
@@ -192,78 +273,124 @@ void serial::start() {
       return;
    }
 
-   buffer_.resize(32);
-
-   status_.clear();
-
-   connected_ = true;
-   collapsed_ = false;
+   set_connected(true);
 
    read_some();
 }
 
 void serial::read_some() {
-   serial_.async_read_some(asio::buffer(buffer_),
-                           [this](auto ec, auto bytes_read) {
-                              if (!ec) {
-                                 split_data(bytes_read);
-                                 read_some();
-                              } else {
-                                 connected_ = false;
-                                 set_error(ec.message());
-                                 close();
-                              }
-                           });
+   serial_.async_read_some(buffer_.prepare(), [this](auto ec, auto bytes_read) {
+      if (!ec) {
+         buffer_.commit(bytes_read);
+         read_marks_.emplace_back(buffer_.size(), clock_t::now());
+         if (should_flush()) {
+            flush();
+         } else {
+            schedule_flush();
+         }
+
+         pending_bytes_.store(input_queue_size(serial_) + buffer_.size(),
+                              std::memory_order_relaxed);
+         read_some();
+      } else {
+         set_error(ec.message());
+         close();
+      }
+   });
 }
 
-void serial::split_data(std::size_t bytes_read) {
-   for (std::size_t i = 0; i < bytes_read; ++i) {
-      auto ch = buffer_[i];
-      if (opts_.mirror) {
-         std::cout << ch;
-      }
+bool serial::should_flush() const {
+   if (opts_.coalesce_us <= 0) {
+      return true;
+   }
 
-      remainder_ += ch;
+   const auto capacity = buffer_.capacity();
+   const auto limit =
+       opts_.coalesce_bytes ? opts_.coalesce_bytes : (capacity / 4);
 
-      if (ends_with(remainder_, opts_.line_separator)) {
-         // It's a line split
-         remainder_.resize(remainder_.size() - opts_.line_separator.size());
-         data_->add_raw_entry(remainder_);
-         remainder_.clear();
+   // Always leave enough space for the next read
+   return buffer_.size() >= limit || buffer_.free_space() < (capacity / 4);
+}
+
+void serial::schedule_flush() {
+   if (flush_scheduled_) {
+      return;
+   }
+
+   flush_scheduled_ = true;
+   flush_timer_.expires_after(std::chrono::microseconds(opts_.coalesce_us));
+   flush_timer_.async_wait([this](auto ec) {
+      if (ec == asio::error::operation_aborted) {
+         return;
       }
+
+      flush_scheduled_ = false;
+      flush();
+   });
+}
+
+void serial::flush() {
+   if (flush_scheduled_) {
+      flush_timer_.cancel();
+      flush_scheduled_ = false;
    }
 
+   if (buffer_.empty()) {
+      return;
+   }
+
+   const auto received_data = buffer_.data();
+   std::size_t begin = 0;
+   for (const auto &[end, received] : read_marks_) {
+      split_data(received_data.substr(begin, end - begin), received);
+      begin = end;
+   }
+   read_marks_.clear();
+   buffer_.consume();
+
+   // Also flushed by the coalescing timer, without a read to follow
+   pending_bytes_.store(input_queue_size(serial_) + buffer_.size(),
+                        std::memory_order_relaxed);
+
+   std::lock_guard<std::mutex> lock{state_mutex_};
+   state_.stats = buffer_.get_stats();
+   state_.buffer_capacity = buffer_.capacity();
+}
+
+void serial::split_data(std::string_view chunk,
+                        clock_t::time_point received) {
    if (opts_.mirror) {
+      std::cout.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
       std::cout.flush();
    }
+
+   framer_.feed(chunk, [this, received](std::string_view line) {
+      latency_->record(ui::latency_stage::framed, received);
+      data_->add_raw_entry(line, received);
+   });
 }
 
 void serial::handle_separator_change() {
-   std::string::size_type from = 0;
-   std::string::size_type to;
-   std::string entry;
-   while (from < remainder_.size()) {
-      to = remainder_.find(opts_.line_separator, from);
-      if (to == std::string::npos) {
-         break;
-      }
+   const auto received = clock_t::now();
+   framer_.set_separator(opts_.line_separator,
+                         [this, received](std::string_view line) {
+                            data_->add_raw_entry(line, received);
+                         });
+}
 
-      entry = remainder_.substr(from, to - from);
-      data_->add_raw_entry(entry);
-      from = to + opts_.line_separator.size();
+void serial::draw() {
+   shared_state state;
+   {
+      std::lock_guard<std::mutex> lock{state_mutex_};
+      state = state_;
+      state_.expand = false;
    }
 
-   if (from != 0) {
-      if (from == remainder_.size()) {
-         remainder_.clear();
-      } else {
-         remainder_ = remainder_.substr(from, remainder_.size() - from);
-      }
+   if (state.expand) {
+      collapsed_ = false;
    }
-}
 
-void serial::draw() {
-   if ((!status_.empty() || !connected_) && !collapsed_) {
+   if ((!state.status.empty() || !state.connected) && !collapsed_) {
       ImGui::SetNextItemOpen(true);
    }
 
@@ -279,57 +406,78 @@ void serial::draw() {
 
    auto next = [] { ImGui::TableNextColumn(); };
 
+   // Serial port is driven by the I/O context, which might be running on a
+   // different thread, so every change is posted to it.
+   auto post = [this](auto fn) { asio::post(serial_.get_executor(), fn); };
+
    auto separator_picker = [&, this] {
       next();
       if (line_separator_picker_->draw()) {
-         opts_.line_separator = line_separator_picker_->separator();
-         handle_separator_change();
+         post([this, separator = line_separator_picker_->separator()] {
+            opts_.line_separator = separator;
+            handle_separator_change();
+         });
       }
    };
 
-   if (!connected_) {
+   if (!state.connected) {
       next();
-      ui::std_input_text("Port", opts_.port);
+      ui::std_input_text("Port", ui_opts_.port);
 
       next();
       if (baud_rate_picker_->draw()) {
-         opts_.baud_rate = baud_rate_picker_->baud_rate();
+         ui_opts_.baud_rate = baud_rate_picker_->baud_rate();
       }
 
       next();
       if (ImGui::Button("Open")) {
-         start();
+         post([this, port = ui_opts_.port, baud_rate = ui_opts_.baud_rate] {
+            opts_.port = port;
+            opts_.baud_rate = baud_rate;
+            open();
+         });
       }
 
       separator_picker();
    } else {
       next();
       if (ImGui::Button("Close")) {
-         close();
+         post([this] { close(); });
       }
 
       separator_picker();
    }
 
    next();
-   ImGui::Checkbox("Mirror to console", &opts_.mirror);
+   if (ImGui::Checkbox("Mirror to console", &ui_opts_.mirror)) {
+      post([this, mirror = ui_opts_.mirror] { opts_.mirror = mirror; });
+   }
 
    ImGui::EndTable();
 
-   if (!status_.empty()) {
+   const auto &stats = state.stats;
+   ImGui::Text("Reads: %llu, %.1f B/read (max %zu B), buffer: %zu B",
+               static_cast<unsigned long long>(stats.completions),
+               stats.bytes_per_completion(), stats.max_completion,
+               state.buffer_capacity);
+
+   if (!state.status.empty()) {
       ImGui::Text("Status: ");
       ImGui::SameLine();
-      ImGui::TextColored({1.0f, 0.0f, 0.0f, 1.0f}, "%s", status_.c_str());
+      ImGui::TextColored({1.0f, 0.0f, 0.0f, 1.0f}, "%s", state.status.c_str());
    } else {
-      ImGui::Text(connected_ ? "Status: operating" : "Status: idle");
+      ImGui::Text(state.connected ? "Status: operating" : "Status: idle");
    }
 }
 
 void serial::close() {
+   flush();
+
    boost::system::error_code ec;
    serial_.close(ec);
    if (ec) {
       set_error(ec.message());
    }
-   connected_ = false;
+   pending_bytes_.store(0, std::memory_order_relaxed);
+   set_connected(false);
 }
@@ -0,0 +1,131 @@
+/**
+ * @file   spill_file.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/spill_file.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace asp::inputs;
+
+namespace bip = boost::interprocess;
+
+namespace {
+
+std::string make_path(const std::string &directory) {
+   std::random_device rd;
+   const auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+   std::ostringstream os;
+   os << directory;
+   if (!directory.empty() && directory.back() != '/' &&
+       directory.back() != '\\') {
+      os << '/';
+   }
+   os << "serial-plotter-" << std::hex << now.count() << "-" << rd()
+      << ".spill";
+   return os.str();
+}
+
+void resize_file(const std::string &path, std::uint64_t size, bool create) {
+   auto mode = std::ios_base::in | std::ios_base::out | std::ios_base::binary;
+   if (create) {
+      mode |= std::ios_base::trunc;
+   }
+
+   std::filebuf file;
+   if (!file.open(path, mode)) {
+      throw std::runtime_error("Unable to open the spill file: " + path);
+   }
+
+   if (size) {
+      file.pubseekoff(static_cast<std::streamoff>(size - 1),
+                      std::ios_base::beg);
+      file.sputc(0);
+   }
+}
+
+//! Blocks take power of two sized slots, starting at a cache line. Block
+//! sizes of the compressed chunks vary, exact sizes would rarely be reused.
+constexpr std::size_t min_slot_shift = 6;
+
+std::size_t slot_class(std::size_t bytes) {
+   std::size_t shift = min_slot_shift;
+   while ((std::size_t{1} << shift) < bytes) {
+      ++shift;
+   }
+   return shift - min_slot_shift;
+}
+
+std::size_t slot_size(std::size_t slot) {
+   return std::size_t{1} << (slot + min_slot_shift);
+}
+
+} // namespace
+
+spill_file::spill_file(const std::string &directory, std::size_t segment_size)
+   : path_{make_path(directory)}
+   , segment_size_{segment_size} {
+   resize_file(path_, 0, true);
+   mapping_ = std::make_unique<bip::file_mapping>(path_.c_str(),
+                                                  bip::read_write);
+}
+
+spill_file::~spill_file() {
+   segments_.clear();
+   mapping_.reset();
+   bip::file_mapping::remove(path_.c_str());
+}
+
+void *spill_file::store(const void *data, std::size_t bytes) {
+   const auto slot = slot_class(bytes);
+   const auto size = slot_size(slot);
+   if (slot >= free_.size()) {
+      free_.resize(slot + 1);
+   }
+
+   void *block = nullptr;
+   auto &free = free_[slot];
+   if (!free.empty()) {
+      block = free.back();
+      free.pop_back();
+   } else {
+      if (size > segment_size_) {
+         throw std::length_error("Spilled block is larger than a segment");
+      }
+
+      if (segments_.empty() || segment_size_ - tail_ < size) {
+         add_segment();
+      }
+
+      block = static_cast<char *>(segments_.back().get_address()) + tail_;
+      tail_ += size;
+   }
+
+   std::memcpy(block, data, bytes);
+   used_ += size;
+   return block;
+}
+
+void spill_file::release(void *block, std::size_t bytes) {
+   const auto slot = slot_class(bytes);
+   free_[slot].push_back(block);
+   used_ -= slot_size(slot);
+}
+
+void spill_file::add_segment() {
+   const auto offset =
+       static_cast<std::uint64_t>(segments_.size()) * segment_size_;
+   resize_file(path_, offset + segment_size_, false);
+
+   segments_.emplace_back(*mapping_, bip::read_write,
+                          static_cast<bip::offset_t>(offset), segment_size_);
+   tail_ = 0;
+}
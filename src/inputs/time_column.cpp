@@ -0,0 +1,110 @@
+/**
+ * @file   time_column.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/inputs/time_column.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace asp::inputs;
+
+void time_column::push_back(time_point time) {
+   const auto first = deltas_.first_index();
+
+   // Timestamps never go back, even if the caller's clock does
+   if (!deltas_.empty()) {
+      time = std::max(time, back());
+   }
+
+   auto delta = [&](const epoch &e) {
+      return std::chrono::duration_cast<resolution_t>(time - e.base).count();
+   };
+
+   if (epochs_.empty() ||
+       delta(epochs_.back()) > std::numeric_limits<delta_t>::max()) {
+      epochs_.push_back({deltas_.end_index(), time});
+   }
+
+   deltas_.push_back(static_cast<delta_t>(delta(epochs_.back())));
+   if (deltas_.first_index() != first) {
+      trim_epochs();
+   }
+}
+
+void time_column::drop_front(std::size_t count) {
+   deltas_.drop_front(count);
+   trim_epochs();
+}
+
+void time_column::set_max_size(std::size_t max_size) {
+   deltas_.set_max_size(max_size);
+   trim_epochs();
+}
+
+void time_column::clear() {
+   deltas_.clear();
+   epochs_.clear();
+}
+
+time_column::time_point time_column::at(std::uint64_t index) const {
+   return to_time(index,
+                  deltas_[static_cast<std::size_t>(index - first_index())]);
+}
+
+std::uint64_t time_column::lower_bound(time_point time) const {
+   constexpr auto chunk_size = decltype(deltas_)::chunk_size;
+
+   // First chunk, starting no earlier than time. The oldest chunk is never
+   // probed, its first sample might have been dropped.
+   auto lo_chunk = first_index() / chunk_size + 1;
+   auto hi_chunk = (end_index() + chunk_size - 1) / chunk_size;
+   while (lo_chunk < hi_chunk) {
+      const auto mid = lo_chunk + (hi_chunk - lo_chunk) / 2;
+      if (to_time(mid * chunk_size, deltas_.chunk_front(mid)) < time) {
+         lo_chunk = mid + 1;
+      } else {
+         hi_chunk = mid;
+      }
+   }
+
+   // The sample is either in the chunk before it, or is its first one
+   std::uint64_t lo = std::max(first_index(), (lo_chunk - 1) * chunk_size);
+   std::uint64_t hi = std::min(end_index(), lo_chunk * chunk_size);
+   while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (at(mid) < time) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return lo;
+}
+
+const time_column::epoch &time_column::find_epoch(std::uint64_t index) const {
+   // Last epoch starting at or before the index, there are only a few of them
+   auto it = std::upper_bound(
+       epochs_.begin(), epochs_.end(), index,
+       [](std::uint64_t idx, const epoch &e) { return idx < e.first_index; });
+   return *std::prev(it);
+}
+
+time_column::time_point time_column::to_time(std::uint64_t index,
+                                             delta_t delta) const {
+   return find_epoch(index).base +
+          std::chrono::duration_cast<clock_t::duration>(resolution_t{delta});
+}
+
+void time_column::trim_epochs() {
+   if (deltas_.empty()) {
+      epochs_.clear();
+      return;
+   }
+
+   while (epochs_.size() > 1 && epochs_[1].first_index <= first_index()) {
+      epochs_.pop_front();
+   }
+}
@@ -19,8 +19,17 @@ result_t<options> options::load(int argc, char **argv) {
    auto window_args = ui::window::options::prepare();
    auto serial_args = inputs::serial::options::prepare();
    auto data_args = inputs::data::options::prepare();
-
-   all.add(general).add(window_args).add(serial_args).add(data_args);
+   auto importer_args = inputs::importer::options::prepare();
+   auto diagnostics_args = ui::diagnostics::options::prepare();
+   auto scheduler_args = ui::scheduler::options::prepare();
+
+   all.add(general)
+       .add(window_args)
+       .add(serial_args)
+       .add(data_args)
+       .add(importer_args)
+       .add(diagnostics_args)
+       .add(scheduler_args);
 
    try {
       po::variables_map vm;
@@ -36,8 +45,11 @@ result_t<options> options::load(int argc, char **argv) {
       auto window = ui::window::options::load(vm);
       auto serial = inputs::serial::options::load(vm);
       auto data = inputs::data::options::load(vm);
+      auto importer = inputs::importer::options::load(vm);
+      auto diagnostics = ui::diagnostics::options::load(vm);
+      auto scheduler = ui::scheduler::options::load(vm);
 
-      return options{window, serial, data};
+      return options{window, serial, data, importer, diagnostics, scheduler};
 
    } catch (std::exception const &e) {
       std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,140 @@
+/**
+ * @file   gl_stream.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/render/detail/gl_stream.h>
+
+#include <glad/glad.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+using namespace asp::render::detail;
+
+namespace {
+
+//! Initial buffer capacity, in bytes
+constexpr std::size_t min_capacity = 64 * 1024;
+
+bool same_state(const ImDrawCmd &a, const ImDrawCmd &b) {
+   return a.TextureId == b.TextureId && a.VtxOffset == b.VtxOffset &&
+          a.ClipRect.x == b.ClipRect.x && a.ClipRect.y == b.ClipRect.y &&
+          a.ClipRect.z == b.ClipRect.z && a.ClipRect.w == b.ClipRect.w;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: gl_state
+////////////////////////////////////////////////////////////////////////////////
+void gl_state::reset() {
+   texture_valid_ = false;
+   scissor_valid_ = false;
+}
+
+void gl_state::bind_texture(unsigned int texture) {
+   if (texture_valid_ && texture_ == texture) {
+      return;
+   }
+
+   glBindTexture(GL_TEXTURE_2D, texture);
+   texture_ = texture;
+   texture_valid_ = true;
+}
+
+void gl_state::scissor(int x, int y, int width, int height) {
+   if (scissor_valid_ && scissor_[0] == x && scissor_[1] == y &&
+       scissor_[2] == width && scissor_[3] == height) {
+      return;
+   }
+
+   glScissor(x, y, width, height);
+   scissor_[0] = x;
+   scissor_[1] = y;
+   scissor_[2] = width;
+   scissor_[3] = height;
+   scissor_valid_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: frame_stream
+////////////////////////////////////////////////////////////////////////////////
+void frame_stream::create() {
+   glGenBuffers(1, &vertices_.id);
+   glGenBuffers(1, &indices_.id);
+}
+
+void frame_stream::destroy() {
+   if (vertices_.id) {
+      glDeleteBuffers(1, &vertices_.id);
+   }
+   if (indices_.id) {
+      glDeleteBuffers(1, &indices_.id);
+   }
+   vertices_ = {};
+   indices_ = {};
+}
+
+void frame_stream::reserve(unsigned int target, buffer &buffer,
+                           std::size_t size) {
+   if (size > buffer.capacity) {
+      buffer.capacity = std::max({buffer.capacity * 2, size, min_capacity});
+   }
+
+   // Orphan the storage still used by the previous frame
+   glBindBuffer(target, buffer.id);
+   glBufferData(target, static_cast<GLsizeiptr>(buffer.capacity), nullptr,
+                GL_STREAM_DRAW);
+}
+
+void frame_stream::upload(const ImDrawData &data) {
+   vertex_offsets_.resize(data.CmdListsCount);
+   index_offsets_.resize(data.CmdListsCount);
+
+   std::size_t vertex_size = 0;
+   std::size_t index_size = 0;
+   for (int n = 0; n < data.CmdListsCount; ++n) {
+      const auto &list = *data.CmdLists[n];
+      vertex_offsets_[n] = vertex_size;
+      index_offsets_[n] = index_size;
+      vertex_size += list.VtxBuffer.Size * sizeof(ImDrawVert);
+      index_size += list.IdxBuffer.Size * sizeof(ImDrawIdx);
+   }
+
+   reserve(GL_ARRAY_BUFFER, vertices_, vertex_size);
+   reserve(GL_ELEMENT_ARRAY_BUFFER, indices_, index_size);
+
+   for (int n = 0; n < data.CmdListsCount; ++n) {
+      const auto &list = *data.CmdLists[n];
+      glBufferSubData(GL_ARRAY_BUFFER,
+                      static_cast<GLintptr>(vertex_offsets_[n]),
+                      list.VtxBuffer.Size * sizeof(ImDrawVert),
+                      list.VtxBuffer.Data);
+      glBufferSubData(GL_ELEMENT_ARRAY_BUFFER,
+                      static_cast<GLintptr>(index_offsets_[n]),
+                      list.IdxBuffer.Size * sizeof(ImDrawIdx),
+                      list.IdxBuffer.Data);
+   }
+}
+
+int asp::render::detail::merge_commands(const ImDrawList &list, int first,
+                                        unsigned int &elem_count) {
+   const auto &cmd = list.CmdBuffer[first];
+   elem_count = cmd.ElemCount;
+
+   auto last = first;
+   while (last + 1 < list.CmdBuffer.Size) {
+      const auto &next = list.CmdBuffer[last + 1];
+      if (next.UserCallback || !same_state(cmd, next) ||
+          next.IdxOffset != cmd.IdxOffset + elem_count) {
+         break;
+      }
+
+      elem_count += next.ElemCount;
+      ++last;
+   }
+   return last;
+}
@@ -15,175 +15,146 @@
 #include <SDL2/SDL_syswm.h>
 #include <glad/glad.h>
 
+#include <asp/render/detail/gl_stream.h>
+
 // Data
 static GLuint g_FontTexture = 0;
 static int g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 static int g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static int g_AttribLocationPosition = 0, g_AttribLocationUV = 0,
            g_AttribLocationColor = 0;
-static unsigned int g_VboHandle = 0, /*g_VaoHandle = 0,*/ g_ElementsHandle = 0;
-
-// This is the main rendering function that you have to implement and provide to
-// ImGui (via setting up 'RenderDrawListsFn' in the ImGuiIO structure) If text
-// or lines are blurry when integrating ImGui in your engine:
-// - in your Render function, try translating your projection matrix by
-// (0.5f,0.5f) or (0.375f,0.375f)
-void ImGui_ImplSdlGLES2_RenderDrawLists(ImDrawData *draw_data) {
-   // Avoid rendering when minimized, scale coordinates for retina displays
-   // (screen coordinates != framebuffer coordinates)
-   ImGuiIO &io = ImGui::GetIO();
-   // Because of some weird handling of Android's virtual keyboard, we have to
-   // check if the Backspace button is pressed
-   const Uint8 *kbState = SDL_GetKeyboardState(NULL);
-   if (!kbState[SDL_SCANCODE_BACKSPACE]) {
-      io.KeysDown[SDLK_BACKSPACE] = 0;
-   }
-   int fb_width = (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x);
-   int fb_height = (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y);
-   if (fb_width == 0 || fb_height == 0)
-      return;
-   draw_data->ScaleClipRects(io.DisplayFramebufferScale);
-
-   // Backup GL state
-   GLint last_active_texture;
-   glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
-   glActiveTexture(GL_TEXTURE0);
-   GLint last_program;
-   glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-   GLint last_texture;
-   glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-   GLint last_array_buffer;
-   glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-   GLint last_element_array_buffer;
-   glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-   // Note that your vertex buffer state is NOT saved, since es2 has no vertex
-   // array objects
-   // GLint last_vertex_array; glGetIntegerv(GL_VERTEX_ARRAY_BINDING,
-   // &last_vertex_array);
-   GLint last_blend_src_rgb;
-   glGetIntegerv(GL_BLEND_SRC_RGB, &last_blend_src_rgb);
-   GLint last_blend_dst_rgb;
-   glGetIntegerv(GL_BLEND_DST_RGB, &last_blend_dst_rgb);
-   GLint last_blend_src_alpha;
-   glGetIntegerv(GL_BLEND_SRC_ALPHA, &last_blend_src_alpha);
-   GLint last_blend_dst_alpha;
-   glGetIntegerv(GL_BLEND_DST_ALPHA, &last_blend_dst_alpha);
-   GLint last_blend_equation_rgb;
-   glGetIntegerv(GL_BLEND_EQUATION_RGB, &last_blend_equation_rgb);
-   GLint last_blend_equation_alpha;
-   glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &last_blend_equation_alpha);
-   GLint last_viewport[4];
-   glGetIntegerv(GL_VIEWPORT, last_viewport);
-   GLint last_scissor_box[4];
-   glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-   GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-   GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-   GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-   GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+static asp::render::detail::frame_stream g_Stream;
+static asp::render::detail::gl_state g_State;
 
+static void ImGui_ImplSdlGLES2_SetupRenderState(ImDrawData *draw_data,
+                                               int fb_width, int fb_height) {
    // Setup render state: alpha-blending enabled, no face culling, no depth
-   // testing, scissor enabled
+   // testing, scissor enabled. The whole state is set every frame instead of
+   // being backed up and restored, glGet* calls stall the pipeline.
    glEnable(GL_BLEND);
    glBlendEquation(GL_FUNC_ADD);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_CULL_FACE);
    glDisable(GL_DEPTH_TEST);
    glEnable(GL_SCISSOR_TEST);
+   glActiveTexture(GL_TEXTURE0);
 
    // Setup viewport, orthographic projection matrix
    glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+   float L = draw_data->DisplayPos.x;
+   float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
+   float T = draw_data->DisplayPos.y;
+   float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
    const float ortho_projection[4][4] = {
-       {2.0f / io.DisplaySize.x, 0.0f, 0.0f, 0.0f},
-       {0.0f, 2.0f / -io.DisplaySize.y, 0.0f, 0.0f},
+       {2.0f / (R - L), 0.0f, 0.0f, 0.0f},
+       {0.0f, 2.0f / (T - B), 0.0f, 0.0f},
        {0.0f, 0.0f, -1.0f, 0.0f},
-       {-1.0f, 1.0f, 0.0f, 1.0f},
+       {(R + L) / (L - R), (T + B) / (B - T), 0.0f, 1.0f},
    };
    glUseProgram(g_ShaderHandle);
    glUniform1i(g_AttribLocationTex, 0);
    glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE,
                       &ortho_projection[0][0]);
-   // glBindVertexArray(g_VaoHandle);
 
+   // No vertex array objects in es2, the attributes are global state
    glEnableVertexAttribArray(g_AttribLocationPosition);
    glEnableVertexAttribArray(g_AttribLocationUV);
    glEnableVertexAttribArray(g_AttribLocationColor);
+   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_Stream.index_buffer());
+   g_State.reset();
+}
 
-   glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+// Points the vertex attributes at the draw list data in the frame buffer
+static void ImGui_ImplSdlGLES2_SetupVertexArray(std::size_t vtx_offset) {
+   glBindBuffer(GL_ARRAY_BUFFER, g_Stream.vertex_buffer());
 #define OFFSETOF(TYPE, ELEMENT) ((size_t) & (((TYPE *)0)->ELEMENT))
-   glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, pos));
-   glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, uv));
-   glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, col));
+   glVertexAttribPointer(
+       g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert),
+       (GLvoid *)(vtx_offset + OFFSETOF(ImDrawVert, pos)));
+   glVertexAttribPointer(
+       g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert),
+       (GLvoid *)(vtx_offset + OFFSETOF(ImDrawVert, uv)));
+   glVertexAttribPointer(
+       g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert),
+       (GLvoid *)(vtx_offset + OFFSETOF(ImDrawVert, col)));
 #undef OFFSETOF
+}
 
-   for (int n = 0; n < draw_data->CmdListsCount; n++) {
-      const ImDrawList *cmd_list = draw_data->CmdLists[n];
-      const ImDrawIdx *idx_buffer_offset = 0;
+// This is the main rendering function that you have to implement and provide to
+// ImGui (via setting up 'RenderDrawListsFn' in the ImGuiIO structure) If text
+// or lines are blurry when integrating ImGui in your engine:
+// - in your Render function, try translating your projection matrix by
+// (0.5f,0.5f) or (0.375f,0.375f)
+void ImGui_ImplSdlGLES2_RenderDrawLists(ImDrawData *draw_data) {
+   // Avoid rendering when minimized, scale coordinates for retina displays
+   // (screen coordinates != framebuffer coordinates)
+   ImGuiIO &io = ImGui::GetIO();
+   // Because of some weird handling of Android's virtual keyboard, we have to
+   // check if the Backspace button is pressed
+   const Uint8 *kbState = SDL_GetKeyboardState(NULL);
+   if (!kbState[SDL_SCANCODE_BACKSPACE]) {
+      io.KeysDown[SDLK_BACKSPACE] = 0;
+   }
+   int fb_width =
+       (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+   int fb_height =
+       (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+   if (fb_width == 0 || fb_height == 0)
+      return;
+   const ImVec2 clip_off = draw_data->DisplayPos;
+   const ImVec2 clip_scale = draw_data->FramebufferScale;
 
-      glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-      glBufferData(GL_ARRAY_BUFFER,
-                   (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert),
-                   (const GLvoid *)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+   ImGui_ImplSdlGLES2_SetupRenderState(draw_data, fb_width, fb_height);
+   g_Stream.upload(*draw_data);
 
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx),
-                   (const GLvoid *)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+   for (int n = 0; n < draw_data->CmdListsCount; n++) {
+      const ImDrawList *cmd_list = draw_data->CmdLists[n];
+      const std::size_t idx_offset = g_Stream.index_offset(n);
+      ImGui_ImplSdlGLES2_SetupVertexArray(g_Stream.vertex_offset(n));
 
       for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
          const ImDrawCmd *pcmd = &cmd_list->CmdBuffer[cmd_i];
          if (pcmd->UserCallback) {
-            pcmd->UserCallback(cmd_list, pcmd);
-         } else {
-            glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
-            glScissor((int)pcmd->ClipRect.x,
-                      (int)(fb_height - pcmd->ClipRect.w),
-                      (int)(pcmd->ClipRect.z - pcmd->ClipRect.x),
-                      (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-            glDrawElements(
-                GL_TRIANGLES, (GLsizei)pcmd->ElemCount,
-                sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
-                idx_buffer_offset);
+            // User callback, registered via ImDrawList::AddCallback(). The
+            // reset one asks to restore the state, changed by a previous one.
+            if (pcmd->UserCallback == ImDrawCallback_ResetRenderState) {
+               ImGui_ImplSdlGLES2_SetupRenderState(draw_data, fb_width,
+                                                   fb_height);
+               ImGui_ImplSdlGLES2_SetupVertexArray(g_Stream.vertex_offset(n));
+            } else {
+               pcmd->UserCallback(cmd_list, pcmd);
+               g_State.reset();
+            }
+            continue;
          }
-         idx_buffer_offset += pcmd->ElemCount;
+
+         // Commands only split by the draw list bookkeeping are drawn at once
+         GLuint elem_count;
+         cmd_i = asp::render::detail::merge_commands(*cmd_list, cmd_i,
+                                                     elem_count);
+
+         // Project the clip rect into the framebuffer space
+         ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x,
+                         (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+         ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x,
+                         (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+         if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+            continue;
+
+         g_State.bind_texture((GLuint)(intptr_t)pcmd->TextureId);
+         g_State.scissor((int)clip_min.x, (int)(fb_height - clip_max.y),
+                         (int)(clip_max.x - clip_min.x),
+                         (int)(clip_max.y - clip_min.y));
+         glDrawElements(
+             GL_TRIANGLES, (GLsizei)elem_count,
+             sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+             (const GLvoid *)(idx_offset +
+                              pcmd->IdxOffset * sizeof(ImDrawIdx)));
       }
    }
 
-   // Restore modified GL state
-   glUseProgram(last_program);
-   glBindTexture(GL_TEXTURE_2D, last_texture);
-   glActiveTexture(last_active_texture);
-   // glBindVertexArray(last_vertex_array);
-   glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-   glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-   glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb,
-                       last_blend_src_alpha, last_blend_dst_alpha);
-   if (last_enable_blend)
-      glEnable(GL_BLEND);
-   else
-      glDisable(GL_BLEND);
-   if (last_enable_cull_face)
-      glEnable(GL_CULL_FACE);
-   else
-      glDisable(GL_CULL_FACE);
-   if (last_enable_depth_test)
-      glEnable(GL_DEPTH_TEST);
-   else
-      glDisable(GL_DEPTH_TEST);
-   if (last_enable_scissor_test)
-      glEnable(GL_SCISSOR_TEST);
-   else
-      glDisable(GL_SCISSOR_TEST);
-   glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2],
-              (GLsizei)last_viewport[3]);
-   glScissor(last_scissor_box[0], last_scissor_box[1],
-             (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+   // Nothing is restored, but the window clears the whole framebuffer
+   glDisable(GL_SCISSOR_TEST);
 }
 
 static const char *ImGui_ImplSdlGLES2_GetClipboardText(void *) {
@@ -276,27 +247,8 @@ bool ImGui_ImplSdlGLES2_CreateDeviceObjects() {
    g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
    g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
 
-   glGenBuffers(1, &g_VboHandle);
-   glGenBuffers(1, &g_ElementsHandle);
-
-   // glGenVertexArrays(1, &g_VaoHandle);
-   // glBindVertexArray(g_VaoHandle);
-   glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-   glEnableVertexAttribArray(g_AttribLocationPosition);
-   glEnableVertexAttribArray(g_AttribLocationUV);
-   glEnableVertexAttribArray(g_AttribLocationColor);
-
-#define OFFSETOF(TYPE, ELEMENT) ((size_t) & (((TYPE *)0)->ELEMENT))
-   glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, pos));
-   glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, uv));
-   glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,
-                         sizeof(ImDrawVert),
-                         (GLvoid *)OFFSETOF(ImDrawVert, col));
-#undef OFFSETOF
+   // The attribute pointers are set per draw list, once the frame is uploaded
+   g_Stream.create();
 
    ImGui_ImplSdlGLES2_CreateFontsTexture();
 
@@ -309,12 +261,7 @@ bool ImGui_ImplSdlGLES2_CreateDeviceObjects() {
 }
 
 void ImGui_ImplSdlGLES2_InvalidateDeviceObjects() {
-   // if (g_VaoHandle) glDeleteVertexArrays(1, &g_VaoHandle);
-   if (g_VboHandle)
-      glDeleteBuffers(1, &g_VboHandle);
-   if (g_ElementsHandle)
-      glDeleteBuffers(1, &g_ElementsHandle);
-   /*g_VaoHandle = */ g_VboHandle = g_ElementsHandle = 0;
+   g_Stream.destroy();
 
    if (g_ShaderHandle && g_VertHandle)
       glDetachShader(g_ShaderHandle, g_VertHandle);
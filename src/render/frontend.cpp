@@ -17,7 +17,7 @@
 
 using namespace asp::render;
 
-frontend::frontend(SDL_Window &window, SDL_GLContext context)
+frontend::frontend(SDL_Window &window, SDL_GLContext context, bool gpu_lines)
    : window_{&window} {
    IMGUI_CHECKVERSION();
    ImGui::CreateContext();
@@ -57,9 +57,15 @@ frontend::frontend(SDL_Window &window, SDL_GLContext context)
    shader_version_ = glsl_version;
    backend_ = backend::make(v, *this);
    backend_->init();
+
+   // Needs vertex array objects and GLSL 1.30 / 3.00 ES
+   if (gpu_lines && (v == version::opengl3 || v == version::gles3)) {
+      lines_ = std::make_unique<line_renderer>(shader_version_, is_es);
+   }
 }
 
 frontend::~frontend() {
+   lines_.reset();
    backend_.reset();
 
    ImGui_ImplSDL2_Shutdown();
@@ -69,6 +75,10 @@ frontend::~frontend() {
 }
 
 void frontend::new_frame() {
+   if (lines_) {
+      lines_->new_frame();
+   }
+
    backend_->new_frame();
    ImGui_ImplSDL2_NewFrame(window_);
    ImGui::NewFrame();
@@ -0,0 +1,237 @@
+/**
+ * @file   line_renderer.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/render/line_renderer.h>
+
+#include <glad/glad.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace asp::render;
+
+namespace {
+
+//! Initial buffer capacity, in vertices
+constexpr std::size_t min_capacity = 4096;
+
+//! Position is bound to the same location in every program, so that the
+//! vertex arrays don't depend on it
+constexpr GLuint position_location = 0;
+
+GLuint compile(GLenum type, const std::string &source) {
+   const auto shader = glCreateShader(type);
+   const auto text = source.c_str();
+   glShaderSource(shader, 1, &text, nullptr);
+   glCompileShader(shader);
+
+   GLint status = GL_FALSE;
+   glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+   if (status != GL_TRUE) {
+      char log[512] = {};
+      glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+      glDeleteShader(shader);
+      throw std::runtime_error(std::string{"Line shader error: "} + log);
+   }
+   return shader;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: line_buffer
+////////////////////////////////////////////////////////////////////////////////
+line_buffer::line_buffer() {
+   glGenVertexArrays(1, &vao_);
+}
+
+line_buffer::~line_buffer() {
+   glDeleteVertexArrays(1, &vao_);
+   if (vbo_) {
+      glDeleteBuffers(1, &vbo_);
+   }
+}
+
+void line_buffer::reset(std::uint64_t first, double x_base) {
+   first_ = first;
+   size_ = 0;
+   x_base_ = x_base;
+}
+
+void line_buffer::append(const vertex *vertices, std::size_t count) {
+   if (count == 0) {
+      return;
+   }
+
+   if (size_ + count > capacity_) {
+      grow(std::max({capacity_ * 2, size_ + count, min_capacity}));
+   }
+
+   glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+   glBufferSubData(GL_ARRAY_BUFFER,
+                   static_cast<GLintptr>(size_ * sizeof(vertex)),
+                   static_cast<GLsizeiptr>(count * sizeof(vertex)), vertices);
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+   size_ += count;
+}
+
+void line_buffer::grow(std::size_t capacity) {
+   GLuint buffer;
+   glGenBuffers(1, &buffer);
+   glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+   glBufferData(GL_COPY_WRITE_BUFFER,
+                static_cast<GLsizeiptr>(capacity * sizeof(vertex)), nullptr,
+                GL_DYNAMIC_DRAW);
+
+   // Uploaded samples are copied on the GPU side
+   if (vbo_) {
+      if (size_) {
+         glBindBuffer(GL_COPY_READ_BUFFER, vbo_);
+         glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                             static_cast<GLsizeiptr>(size_ * sizeof(vertex)));
+         glBindBuffer(GL_COPY_READ_BUFFER, 0);
+      }
+      glDeleteBuffers(1, &vbo_);
+   }
+   glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+   vbo_ = buffer;
+   capacity_ = capacity;
+
+   // Called while building the frame, the renderers bind their own vertex
+   // arrays once it is drawn
+   glBindVertexArray(vao_);
+   glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+   glEnableVertexAttribArray(position_location);
+   glVertexAttribPointer(position_location, 2, GL_FLOAT, GL_FALSE,
+                         sizeof(vertex), nullptr);
+   glBindVertexArray(0);
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: line_renderer
+////////////////////////////////////////////////////////////////////////////////
+line_renderer::line_renderer(const std::string &shader_version, bool es) {
+   const std::string header =
+       shader_version + "\n" + (es ? "precision highp float;\n" : "");
+
+   const auto vertex_shader = compile(GL_VERTEX_SHADER, header + R"(
+in vec2 Position;
+uniform vec4 Transform;
+void main() {
+   gl_Position = vec4(Position * Transform.xy + Transform.zw, 0.0, 1.0);
+}
+)");
+
+   const auto fragment_shader = compile(GL_FRAGMENT_SHADER, header + R"(
+uniform vec4 Color;
+out vec4 Out_Color;
+void main() {
+   Out_Color = Color;
+}
+)");
+
+   program_ = glCreateProgram();
+   glAttachShader(program_, vertex_shader);
+   glAttachShader(program_, fragment_shader);
+   glBindAttribLocation(program_, position_location, "Position");
+   glLinkProgram(program_);
+
+   glDetachShader(program_, vertex_shader);
+   glDetachShader(program_, fragment_shader);
+   glDeleteShader(vertex_shader);
+   glDeleteShader(fragment_shader);
+
+   GLint status = GL_FALSE;
+   glGetProgramiv(program_, GL_LINK_STATUS, &status);
+   if (status != GL_TRUE) {
+      glDeleteProgram(program_);
+      throw std::runtime_error("Line shader link error");
+   }
+
+   transform_location_ = glGetUniformLocation(program_, "Transform");
+   color_location_ = glGetUniformLocation(program_, "Color");
+}
+
+line_renderer::~line_renderer() {
+   glDeleteProgram(program_);
+}
+
+void line_renderer::new_frame() {
+   draws_.clear();
+}
+
+void line_renderer::draw(ImDrawList &draw_list, const line_buffer &buffer,
+                         std::uint64_t first, std::size_t count,
+                         const transform &xform, std::uint32_t color) {
+   if (count < 2 || first < buffer.first_index() ||
+       first + count > buffer.end_index()) {
+      return;
+   }
+
+   const auto rgba = ImGui::ColorConvertU32ToFloat4(color);
+
+   draw_cmd cmd{};
+   cmd.self = this;
+   cmd.vao = buffer.vertex_array();
+   cmd.first = static_cast<int>(first - buffer.first_index());
+   cmd.count = static_cast<int>(count);
+   cmd.xform = xform;
+   cmd.color[0] = rgba.x;
+   cmd.color[1] = rgba.y;
+   cmd.color[2] = rgba.z;
+   cmd.color[3] = rgba.w;
+   draws_.push_back(cmd);
+
+   // The draw uses the clip rect of the current draw command, the renderer
+   // state is set up again after it
+   draw_list.AddCallback(&line_renderer::render, &draws_.back());
+   draw_list.AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void line_renderer::render(const ImDrawList *, const ImDrawCmd *cmd) {
+   const auto &draw = *static_cast<const draw_cmd *>(cmd->UserCallbackData);
+   const auto &self = *draw.self;
+   const auto &data = *ImGui::GetDrawData();
+
+   // Pixels to the normalized device coordinates
+   const double width = data.DisplaySize.x;
+   const double height = data.DisplaySize.y;
+   const auto &xform = draw.xform;
+   const float transform[4] = {
+       static_cast<float>(xform.scale_x * 2.0 / width),
+       static_cast<float>(-xform.scale_y * 2.0 / height),
+       static_cast<float>((xform.offset_x - data.DisplayPos.x) * 2.0 / width -
+                          1.0),
+       static_cast<float>(1.0 - (xform.offset_y - data.DisplayPos.y) * 2.0 /
+                                    height)};
+
+   const auto scale = data.FramebufferScale;
+   const auto fb_height = static_cast<int>(height * scale.y);
+   const ImVec2 clip_min{(cmd->ClipRect.x - data.DisplayPos.x) * scale.x,
+                         (cmd->ClipRect.y - data.DisplayPos.y) * scale.y};
+   const ImVec2 clip_max{(cmd->ClipRect.z - data.DisplayPos.x) * scale.x,
+                         (cmd->ClipRect.w - data.DisplayPos.y) * scale.y};
+   if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y) {
+      return;
+   }
+
+   glEnable(GL_SCISSOR_TEST);
+   glScissor(static_cast<GLint>(clip_min.x),
+             static_cast<GLint>(fb_height - clip_max.y),
+             static_cast<GLsizei>(clip_max.x - clip_min.x),
+             static_cast<GLsizei>(clip_max.y - clip_min.y));
+
+   glUseProgram(self.program_);
+   glUniform4fv(self.transform_location_, 1, transform);
+   glUniform4fv(self.color_location_, 1, draw.color);
+   glBindVertexArray(draw.vao);
+   glDrawArrays(GL_LINE_STRIP, draw.first, draw.count);
+}
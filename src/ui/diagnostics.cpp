@@ -0,0 +1,227 @@
+/**
+ * @file   diagnostics.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/options.h>
+#include <asp/ui/diagnostics.h>
+
+#include <imgui.h>
+#include <implot.h>
+
+#include <iostream>
+
+using namespace asp::ui;
+
+asp::po_desc_t diagnostics::options::prepare() {
+   namespace po = boost::program_options;
+
+   po::options_description od("Diagnostics Options");
+
+   // clang-format off
+   od.add_options()
+       ("latency-report", po::value<int>()->default_value(0),
+        "Print end-to-end latencies to the standard output every N seconds (0 - never)")
+       ("profile-frames", "Start with the frame stage profiler enabled")
+       ;
+   // clang-format on
+
+   return od;
+}
+
+diagnostics::options diagnostics::options::load(po_vars_t &vm) {
+   diagnostics::options opts;
+   opts.latency_report = vm["latency-report"].as<int>();
+   opts.profile_frames = vm.count("profile-frames") != 0;
+   return opts;
+}
+
+diagnostics::diagnostics(const asp::options &opts,
+                         boost::asio::io_context &ctx)
+   : opts_{opts.diagnostics}
+   , rotation_timer_{ctx}
+   , report_timer_{ctx} {
+   profiler_.set_enabled(opts_.profile_frames);
+
+   rotation_timer_.expires_after(latency_tracker::rotation_period);
+   schedule_rotation();
+
+   if (opts_.latency_report > 0) {
+      report_timer_.expires_after(std::chrono::seconds(opts_.latency_report));
+      schedule_report();
+   }
+}
+
+diagnostics::~diagnostics() {
+   if (opts_.latency_report > 0) {
+      print_latency(std::cout);
+   }
+}
+
+void diagnostics::frame_swapped() {
+   latency_.frame_swapped();
+   profiler_.frame_done();
+}
+
+void diagnostics::schedule_rotation() {
+   rotation_timer_.async_wait([this](auto error) {
+      if (error == boost::asio::error::operation_aborted) {
+         return;
+      }
+
+      latency_.rotate();
+
+      // Fixed cadence, a late wake-up doesn't shift the following periods
+      rotation_timer_.expires_at(rotation_timer_.expiry() +
+                                 latency_tracker::rotation_period);
+      schedule_rotation();
+   });
+}
+
+void diagnostics::schedule_report() {
+   report_timer_.async_wait([this](auto error) {
+      if (error == boost::asio::error::operation_aborted) {
+         return;
+      }
+
+      print_latency(std::cout);
+
+      report_timer_.expires_at(report_timer_.expiry() +
+                               std::chrono::seconds(opts_.latency_report));
+      schedule_report();
+   });
+}
+
+void diagnostics::print_latency(std::ostream &os) const {
+   os << "Latency, us:";
+   for (std::size_t i = 0; i < latency_tracker::stage_count; ++i) {
+      const auto stage = static_cast<latency_stage>(i);
+      const auto summary = latency_.get_summary(stage);
+      os << " " << to_string(stage) << " p50=" << summary.p50.count()
+         << " p99=" << summary.p99.count() << " max=" << summary.max.count()
+         << " n=" << summary.count << ";";
+   }
+   os << std::endl;
+}
+
+void diagnostics::draw() {
+   if (!ImGui::CollapsingHeader("Diagnostics##diagnostics")) {
+      return;
+   }
+
+   draw_latency();
+   draw_profiler();
+}
+
+void diagnostics::draw_latency() {
+   ImGui::TextUnformatted("Latency since the serial read completion, last "
+                          "5-10 seconds:");
+
+   const auto flags = ImGuiTableFlags_SizingFixedFit |
+                      ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+   if (!ImGui::BeginTable("latency##diagnostics", 5, flags)) {
+      return;
+   }
+
+   ImGui::TableSetupColumn("Stage");
+   ImGui::TableSetupColumn("p50, ms");
+   ImGui::TableSetupColumn("p99, ms");
+   ImGui::TableSetupColumn("Max, ms");
+   ImGui::TableSetupColumn("Samples");
+   ImGui::TableHeadersRow();
+
+   auto ms = [](latency_histogram::duration d) {
+      return static_cast<double>(d.count()) / 1000.0;
+   };
+
+   for (std::size_t i = 0; i < latency_tracker::stage_count; ++i) {
+      const auto stage = static_cast<latency_stage>(i);
+      const auto summary = latency_.get_summary(stage);
+
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(to_string(stage));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", ms(summary.p50));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", ms(summary.p99));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", ms(summary.max));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(summary.count));
+   }
+
+   ImGui::EndTable();
+}
+
+void diagnostics::draw_profiler() {
+   bool enabled = profiler_.enabled();
+   if (ImGui::Checkbox("Frame stage profiler##diagnostics", &enabled)) {
+      profiler_.set_enabled(enabled);
+   }
+
+   const auto frames = profiler_.size();
+   if (!enabled || frames == 0) {
+      return;
+   }
+
+   constexpr auto stages = frame_profiler::stage_count;
+
+   // Every stage is shaded between the sum of the previous ones and its own
+   frame_index_.resize(frames);
+   stacked_.assign((stages + 1) * frames, 0.0f);
+   for (std::size_t f = 0; f < frames; ++f) {
+      frame_index_[f] = static_cast<float>(f);
+
+      const auto &frame = profiler_.at(f);
+      for (std::size_t s = 0; s < stages; ++s) {
+         stacked_[(s + 1) * frames + f] = stacked_[s * frames + f] + frame[s];
+      }
+   }
+
+   if (ImPlot::BeginPlot("Frame stages##diagnostics", {-1, 200},
+                         ImPlotFlags_NoTitle)) {
+      ImPlot::SetupAxis(ImAxis_X1, nullptr,
+                        ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_AutoFit);
+      ImPlot::SetupAxis(ImAxis_Y1, "ms", ImPlotAxisFlags_AutoFit);
+
+      const auto count = static_cast<int>(frames);
+      for (std::size_t s = 0; s < stages; ++s) {
+         const auto stage = static_cast<frame_stage>(s);
+         ImPlot::PlotShaded(to_string(stage), frame_index_.data(),
+                            stacked_.data() + s * frames,
+                            stacked_.data() + (s + 1) * frames, count);
+      }
+      ImPlot::EndPlot();
+   }
+
+   const auto flags = ImGuiTableFlags_SizingFixedFit |
+                      ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+   if (!ImGui::BeginTable("profiler##diagnostics", 4, flags)) {
+      return;
+   }
+
+   ImGui::TableSetupColumn("Stage");
+   ImGui::TableSetupColumn("Min, ms");
+   ImGui::TableSetupColumn("Avg, ms");
+   ImGui::TableSetupColumn("p99, ms");
+   ImGui::TableHeadersRow();
+
+   for (std::size_t s = 0; s < stages; ++s) {
+      const auto stage = static_cast<frame_stage>(s);
+      const auto summary = profiler_.get_summary(stage);
+
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(to_string(stage));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", summary.min);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", summary.avg);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", summary.p99);
+   }
+
+   ImGui::EndTable();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file   frame_profiler.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/ui/frame_profiler.h>
+
+#include <algorithm>
+
+using namespace asp::ui;
+
+const char *asp::ui::to_string(frame_stage stage) {
+   switch (stage) {
+      case frame_stage::events:
+         return "Events";
+      case frame_stage::drain:
+         return "Drain";
+      case frame_stage::ui:
+         return "UI";
+      case frame_stage::plot:
+         return "Plot";
+      case frame_stage::render:
+         return "Render";
+      case frame_stage::swap:
+         return "Swap";
+      case frame_stage::io:
+         return "I/O";
+      case frame_stage::count:
+         break;
+   }
+   return "Unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: frame_profiler
+////////////////////////////////////////////////////////////////////////////////
+void frame_profiler::begin(frame_stage stage) {
+   if (!enabled_) {
+      return;
+   }
+
+   if (depth_ < max_depth) {
+      open_[depth_] = {stage, clock_t::now(), clock_t::duration::zero()};
+   }
+   ++depth_;
+}
+
+void frame_profiler::end() {
+   if (!enabled_ || depth_ == 0) {
+      return;
+   }
+
+   if (--depth_ >= max_depth) {
+      return;
+   }
+
+   const auto &open = open_[depth_];
+   const auto elapsed = clock_t::now() - open.start;
+   if (depth_ > 0) {
+      open_[depth_ - 1].nested += elapsed;
+   }
+
+   using ms = std::chrono::duration<float, std::milli>;
+   current_[static_cast<std::size_t>(open.stage)] +=
+       std::chrono::duration_cast<ms>(elapsed - open.nested).count();
+}
+
+void frame_profiler::frame_done() {
+   if (enabled_) {
+      frames_[next_] = current_;
+      next_ = (next_ + 1) % frame_count;
+      size_ = std::min(size_ + 1, frame_count);
+   }
+   current_ = {};
+
+   if (depth_ == 0) {
+      enabled_ = requested_;
+   }
+}
+
+frame_profiler::summary frame_profiler::get_summary(frame_stage stage) const {
+   summary result;
+   if (size_ == 0) {
+      return result;
+   }
+
+   const auto idx = static_cast<std::size_t>(stage);
+   sorted_.clear();
+   for (std::size_t i = 0; i < size_; ++i) {
+      sorted_.push_back(at(i)[idx]);
+   }
+
+   float sum = 0;
+   for (const auto value : sorted_) {
+      sum += value;
+   }
+   result.avg = sum / static_cast<float>(size_);
+
+   const auto p99 = sorted_.begin() + (sorted_.size() - 1) * 99 / 100;
+   std::nth_element(sorted_.begin(), p99, sorted_.end());
+   result.p99 = *p99;
+   result.min = *std::min_element(sorted_.begin(), p99 + 1);
+   return result;
+}
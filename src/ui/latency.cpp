@@ -0,0 +1,146 @@
+/**
+ * @file   latency.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/ui/latency.h>
+
+#include <algorithm>
+
+using namespace asp::ui;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: latency_histogram
+////////////////////////////////////////////////////////////////////////////////
+void latency_histogram::record(std::chrono::steady_clock::duration latency) {
+   const auto us = static_cast<std::uint64_t>(
+       std::max<std::int64_t>(
+           std::chrono::duration_cast<duration>(latency).count(), 0));
+
+   auto &w = windows_[current_.load(std::memory_order_relaxed)];
+   w.buckets[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+
+   auto max = w.max.load(std::memory_order_relaxed);
+   while (us > max &&
+          !w.max.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+   }
+}
+
+void latency_histogram::rotate() {
+   // Samples recorded into the older window while it is being cleared are
+   // lost, that's fine for the statistics
+   const auto next = 1 - current_.load(std::memory_order_relaxed);
+   auto &w = windows_[next];
+   for (auto &bucket : w.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+   }
+   w.max.store(0, std::memory_order_relaxed);
+
+   current_.store(next, std::memory_order_relaxed);
+}
+
+latency_histogram::summary latency_histogram::get_summary() const {
+   std::array<std::uint64_t, bucket_count> counts{};
+   summary result;
+
+   for (const auto &w : windows_) {
+      for (std::size_t i = 0; i < bucket_count; ++i) {
+         counts[i] += w.buckets[i].load(std::memory_order_relaxed);
+      }
+      result.max = std::max(
+          result.max, duration(w.max.load(std::memory_order_relaxed)));
+   }
+
+   for (auto count : counts) {
+      result.count += count;
+   }
+
+   if (result.count == 0) {
+      return result;
+   }
+
+   auto percentile = [&](std::uint64_t rank) {
+      std::uint64_t seen = 0;
+      for (std::size_t i = 0; i < bucket_count; ++i) {
+         seen += counts[i];
+         if (seen >= rank) {
+            return std::min(duration(bucket_limit(i)), result.max);
+         }
+      }
+      return result.max;
+   };
+
+   result.p50 = percentile((result.count + 1) / 2);
+   result.p99 = percentile(result.count - result.count / 100);
+   return result;
+}
+
+std::size_t latency_histogram::bucket_index(std::uint64_t us) {
+   constexpr std::uint64_t sub_buckets = 1 << sub_bits;
+   if (us < sub_buckets) {
+      return static_cast<std::size_t>(us);
+   }
+
+   unsigned msb = sub_bits;
+   while (us >> (msb + 1)) {
+      ++msb;
+   }
+
+   // Top sub_bits after the most significant one select the sub-bucket
+   const auto sub = (us >> (msb - sub_bits)) & (sub_buckets - 1);
+   const auto idx = ((msb - sub_bits + 1) << sub_bits) + sub;
+   return std::min<std::size_t>(idx, bucket_count - 1);
+}
+
+std::uint64_t latency_histogram::bucket_limit(std::size_t idx) {
+   constexpr std::uint64_t sub_buckets = 1 << sub_bits;
+   if (idx < sub_buckets) {
+      return idx;
+   }
+
+   const auto msb = (idx >> sub_bits) + sub_bits - 1;
+   const auto sub = idx & (sub_buckets - 1);
+   return ((sub_buckets + sub + 1) << (msb - sub_bits)) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: latency_tracker
+////////////////////////////////////////////////////////////////////////////////
+const char *asp::ui::to_string(latency_stage stage) {
+   switch (stage) {
+      case latency_stage::framed:
+         return "Framed";
+      case latency_stage::parsed:
+         return "Parsed";
+      case latency_stage::drawn:
+         return "Drawn";
+      case latency_stage::swapped:
+         return "Swapped";
+      case latency_stage::count:
+         break;
+   }
+   return "Unknown";
+}
+
+void latency_tracker::frame_drawn(clock_t::time_point oldest_received) {
+   const auto now = clock_t::now();
+   record(latency_stage::drawn, oldest_received, now);
+
+   frame_has_samples_ = true;
+   frame_oldest_ = oldest_received;
+}
+
+void latency_tracker::frame_swapped() {
+   const auto now = clock_t::now();
+   if (frame_has_samples_) {
+      record(latency_stage::swapped, frame_oldest_, now);
+      frame_has_samples_ = false;
+   }
+}
+
+void latency_tracker::rotate() {
+   for (auto &histogram : histograms_) {
+      histogram.rotate();
+   }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file   log_record.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/ui/log_record.h>
+
+#include <charconv>
+#include <cstdio>
+
+using namespace asp::ui;
+
+namespace {
+
+template <typename T>
+void append_integer(std::string &out, T value, int base = 10) {
+   char buf[24];
+   const auto res = std::to_chars(buf, buf + sizeof(buf), value, base);
+   out.append(buf, res.ptr);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: log_record
+////////////////////////////////////////////////////////////////////////////////
+void log_record::format_to(std::string &out) const {
+   std::string_view fmt{format};
+   std::size_t arg = 0;
+
+   while (!fmt.empty()) {
+      const auto pos = fmt.find("{}");
+      out.append(fmt.substr(0, pos));
+      if (pos == std::string_view::npos) {
+         break;
+      }
+      fmt.remove_prefix(pos + 2);
+
+      // Missing arguments are left as placeholders
+      if (arg == count) {
+         out.append("{}");
+         continue;
+      }
+
+      const auto &value = values[arg];
+      switch (types[arg++]) {
+         case arg_type::integer:
+            append_integer(out, value.integer);
+            break;
+
+         case arg_type::unsigned_integer:
+            append_integer(out, value.unsigned_integer);
+            break;
+
+         case arg_type::hex:
+            out.append("0x");
+            append_integer(out, value.unsigned_integer, 16);
+            break;
+
+         case arg_type::real: {
+            char buf[32];
+            const auto size =
+                std::snprintf(buf, sizeof(buf), "%g", value.real);
+            out.append(buf, static_cast<std::size_t>(std::max(size, 0)));
+            break;
+         }
+
+         case arg_type::text:
+            out.append(text + value.text.offset, value.text.size);
+            break;
+      }
+   }
+}
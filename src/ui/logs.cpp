@@ -8,10 +8,25 @@
 
 #include <imgui.h>
 
+#include <cstddef>
+#include <cstring>
+
 using namespace asp::ui;
 
+namespace {
+
+//! Maximal number of entries kept
+constexpr std::size_t max_entries = 100000;
+
+//! Maximal size of the kept entry text, in bytes
+constexpr std::size_t arena_size = 8 << 20;
+
+} // namespace
+
 logs::logs()
-   : auto_scroll_id_("Autoscroll##logs")
+   : entries_(max_entries)
+   , arena_(arena_size)
+   , auto_scroll_id_("Autoscroll##logs")
    , clear_id_("Clear##logs")
    , child_id_("Logs##logs")
    , copy_id_("Copy##logs") {
@@ -26,11 +41,27 @@ void logs::draw() {
    ImGui::Checkbox(auto_scroll_id_.c_str(), &auto_scroll_);
    ImGui::SameLine();
    if (ImGui::Button(clear_id_.c_str())) {
-      logs_.clear();
+      clear();
    }
 
    ImGui::SameLine();
-   bool copy_to_clipboard = ImGui::Button(copy_id_.c_str());
+   if (ImGui::Button(copy_id_.c_str())) {
+      // The clipper only submits the visible rows, so the ImGui logging
+      // would only capture those
+      std::string all;
+      for (std::size_t i = 0; i < count_; ++i) {
+         all.append(line(i));
+         all.push_back('\n');
+      }
+      ImGui::SetClipboardText(all.c_str());
+   }
+
+   const auto lost = dropped();
+   if (lost) {
+      ImGui::SameLine();
+      ImGui::TextDisabled("%llu entries dropped",
+                          static_cast<unsigned long long>(lost));
+   }
 
    const float height = ImGui::GetTextLineHeightWithSpacing() * 8;
 
@@ -38,16 +69,13 @@ void logs::draw() {
                      ImGuiWindowFlags_HorizontalScrollbar);
    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4, 1));
 
-   if (copy_to_clipboard) {
-      ImGui::LogToClipboard();
-   }
-
-   for (const auto &line : logs_) {
-      ImGui::TextUnformatted(line.c_str());
-   }
-
-   if (copy_to_clipboard) {
-      ImGui::LogFinish();
+   ImGuiListClipper clipper;
+   clipper.Begin(static_cast<int>(count_));
+   while (clipper.Step()) {
+      for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+         const auto entry = line(static_cast<std::size_t>(i));
+         ImGui::TextUnformatted(entry.data(), entry.data() + entry.size());
+      }
    }
 
    if (auto_scroll_) {
@@ -58,6 +86,74 @@ void logs::draw() {
    ImGui::EndChild();
 }
 
-void logs::add_entry(const std::string &entry) {
-   logs_.push_back(entry);
+bool logs::drain() {
+   changed_.store(false);
+
+   // Only the used part of the record text is kept
+   const auto count = queue_.consume_all([this](const log_record &record) {
+      append(reinterpret_cast<const char *>(&record),
+             offsetof(log_record, text) + record.text_used);
+   });
+   return count != 0;
+}
+
+void logs::push(const log_record &record) {
+   if (!queue_.bounded_push(record)) {
+      lost_.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   if (!changed_.exchange(true) && notify_) {
+      notify_();
+   }
+}
+
+void logs::append(const char *data, std::size_t size) {
+   // The entry has to be contiguous, so it is written at the arena start if
+   // it doesn't fit at the end. Whatever is left past the write position is
+   // the oldest one.
+   if (write_pos_ + size > arena_.size()) {
+      while (count_ && at(0).offset >= write_pos_) {
+         pop_oldest();
+      }
+      write_pos_ = 0;
+   }
+
+   while (count_ && at(0).offset >= write_pos_ &&
+          at(0).offset < write_pos_ + size) {
+      pop_oldest();
+   }
+
+   if (count_ == entries_.size()) {
+      pop_oldest();
+   }
+
+   std::memcpy(arena_.data() + write_pos_, data, size);
+   entries_[(first_ + count_) % entries_.size()] = {write_pos_, size};
+   ++count_;
+   write_pos_ += size;
+}
+
+std::string_view logs::text(const entry &e) {
+   // Records are stored unaligned
+   log_record record;
+   std::memcpy(&record, arena_.data() + e.offset, e.size);
+
+   scratch_.clear();
+   record.format_to(scratch_);
+   return scratch_;
+}
+
+void logs::pop_oldest() {
+   first_ = (first_ + 1) % entries_.size();
+   --count_;
+   ++dropped_;
+}
+
+void logs::clear() {
+   first_ = 0;
+   count_ = 0;
+   write_pos_ = 0;
+   dropped_ = 0;
+   lost_ = 0;
 }
@@ -0,0 +1,227 @@
+/**
+ * @file   scheduler.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include <asp/options.h>
+#include <asp/ui/scheduler.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+using namespace asp::ui;
+
+namespace {
+
+using namespace std::chrono_literals;
+using duration_t = scheduler::clock_t::duration;
+
+//! Assumed frame period until the first frames are measured
+constexpr duration_t default_period = 16667us;
+
+//! Ready handlers have to run even without a backlog, e.g. to start the
+//! next read
+constexpr duration_t min_budget = 1ms;
+
+//! Left to the frame, on top of the measured rendering cost
+constexpr duration_t safety_margin = 1ms;
+
+//! Longer gaps between frames are idle waits, not frame periods
+constexpr duration_t max_period = 100ms;
+
+//! Share of the free frame time, given to the ingest by the smooth policy
+constexpr int smooth_share_percent = 50;
+
+//! The throughput policy still draws every that many frames
+constexpr int max_frames_given_up = 3;
+
+//! Number of I/O runs in a row, using up their whole budget, before the
+//! ingest counts as falling behind
+constexpr int behind_after_runs = 2;
+
+void average(duration_t &avg, duration_t sample) {
+   // Exponential moving average with 1/8 weight of the new sample
+   avg = avg == duration_t::zero() ? sample : avg + (sample - avg) / 8;
+}
+
+double to_ms(duration_t d) {
+   return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: scheduler::options
+////////////////////////////////////////////////////////////////////////////////
+asp::po_desc_t scheduler::options::prepare() {
+   namespace po = boost::program_options;
+
+   po::options_description od("Scheduling Options");
+
+   // clang-format off
+   od.add_options()
+       ("schedule", po::value<std::string>()->default_value("smooth"),
+        "Splitting the UI thread time between rendering and the serial input, one of: latency (never skip a frame, ingest in the rest of it), smooth (steady share of the frame for the ingest), throughput (skip frames while falling behind the input)")
+       ;
+   // clang-format on
+
+   return od;
+}
+
+scheduler::options scheduler::options::load(po_vars_t &vm) {
+   using namespace std::string_literals;
+
+   scheduler::options opts;
+   const auto schedule = vm["schedule"].as<std::string>();
+   if (schedule == "latency") {
+      opts.schedule = policy::latency;
+   } else if (schedule == "smooth") {
+      opts.schedule = policy::smooth;
+   } else if (schedule == "throughput") {
+      opts.schedule = policy::throughput;
+   } else {
+      throw boost::program_options::error("Invalid schedule value: "s +
+                                          schedule);
+   }
+   return opts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: scheduler
+////////////////////////////////////////////////////////////////////////////////
+scheduler::scheduler(const asp::options &opts)
+   : opts_{opts.scheduler} {
+   // Nothing to do here
+}
+
+duration_t scheduler::slack() const {
+   const auto period = stats_.frame_period == duration_t::zero()
+                           ? default_period
+                           : stats_.frame_period;
+
+   return std::max(period - stats_.draw_cost - safety_margin, min_budget);
+}
+
+scheduler::plan scheduler::begin_frame(const backlog &backlog) {
+   // The I/O used up its whole budget for a few runs in a row: ingest can't
+   // keep up. Only the inline ingest gains from the frames given up.
+   const bool behind = inline_ingest_ && !backlog.empty() &&
+                       exhausted_in_row_ >= behind_after_runs;
+
+   plan result;
+   if (backlog.empty()) {
+      result.ingest_budget = min_budget;
+   } else {
+      switch (opts_.schedule) {
+         case policy::latency:
+            result.ingest_budget = slack();
+            break;
+
+         case policy::smooth:
+            result.ingest_budget =
+                std::max(slack() * smooth_share_percent / 100, min_budget);
+            break;
+
+         case policy::throughput:
+            if (behind && skipped_in_row_ < max_frames_given_up) {
+               result.render = false;
+               result.ingest_budget = std::max(slack(), stats_.frame_period);
+            } else {
+               result.ingest_budget = slack();
+            }
+            break;
+      }
+   }
+
+   if (result.render) {
+      skipped_in_row_ = 0;
+   } else {
+      ++skipped_in_row_;
+      ++stats_.frames;
+      ++stats_.frames_given_up;
+
+      // The next swap interval spans more than one frame
+      last_swap_ = {};
+   }
+
+   stats_.last_backlog = backlog;
+   average(stats_.ingest_budget, result.ingest_budget);
+
+   plan_ = result;
+   return result;
+}
+
+void scheduler::ingest_done(duration_t spent) {
+   average(stats_.ingest_spent, spent);
+   ++stats_.ingest_runs;
+   if (spent >= plan_.ingest_budget) {
+      ++stats_.budget_exhausted;
+      ++exhausted_in_row_;
+   } else {
+      exhausted_in_row_ = 0;
+   }
+}
+
+void scheduler::frame_drawn(duration_t draw, clock_t::time_point swapped) {
+   average(stats_.draw_cost, draw);
+   ++stats_.frames;
+
+   if (last_swap_ != clock_t::time_point{}) {
+      const auto period = swapped - last_swap_;
+      if (period < max_period) {
+         average(stats_.frame_period, period);
+      }
+   }
+   last_swap_ = swapped;
+}
+
+void scheduler::draw() {
+   if (!ImGui::CollapsingHeader("Scheduler")) {
+      return;
+   }
+
+   const char *policies[] = {to_string(policy::latency),
+                             to_string(policy::smooth),
+                             to_string(policy::throughput)};
+   auto current = static_cast<int>(opts_.schedule);
+   if (ImGui::Combo("Policy", &current, policies, 3)) {
+      opts_.schedule = static_cast<policy>(current);
+   }
+
+   ImGui::Text("Frame period: %.2f ms", to_ms(stats_.frame_period));
+   ImGui::Text("Rendering: %.2f ms", to_ms(stats_.draw_cost));
+   ImGui::Text("Ingest cap: %.2f ms, used %.2f ms",
+               to_ms(stats_.ingest_budget), to_ms(stats_.ingest_spent));
+   ImGui::TextDisabled("The cap only bounds the I/O polling, it stops early "
+                       "once no handler is ready");
+   const auto &backlog = stats_.last_backlog;
+   ImGui::Text("Backlog: %llu bytes, %llu samples",
+               static_cast<unsigned long long>(backlog.pending_bytes),
+               static_cast<unsigned long long>(backlog.queued_samples));
+
+   auto percent = [](std::uint64_t part, std::uint64_t total) {
+      return 100.0 * static_cast<double>(part) /
+             static_cast<double>(std::max<std::uint64_t>(total, 1));
+   };
+
+   ImGui::Text("Frames given up: %llu (%.1f%% of the frames)",
+               static_cast<unsigned long long>(stats_.frames_given_up),
+               percent(stats_.frames_given_up, stats_.frames));
+   ImGui::Text("Cap reached: %llu (%.1f%% of the I/O runs)",
+               static_cast<unsigned long long>(stats_.budget_exhausted),
+               percent(stats_.budget_exhausted, stats_.ingest_runs));
+}
+
+const char *asp::ui::to_string(scheduler::policy policy) {
+   switch (policy) {
+      case scheduler::policy::latency:
+         return "Latency";
+      case scheduler::policy::smooth:
+         return "Smooth";
+      case scheduler::policy::throughput:
+         return "Throughput";
+   }
+   return "Unknown";
+}
@@ -13,10 +13,21 @@
 
 #include <implot.h>
 
+#include <atomic>
+
 using namespace asp::ui;
 
 namespace {
 
+//! How long to block without anything to draw. In the on-change mode the
+//! I/O runs on the ingest thread, so the wait can be long: new data wakes
+//! the window up anyway. Otherwise the I/O runs between the updates.
+constexpr int idle_wait_ms = 250;
+constexpr int hidden_poll_ms = 10;
+
+//! SDL user event type, sent by window::wake(), zero if there is no window
+std::atomic<Uint32> wake_event{0};
+
 void throw_sdl_error(const std::string &func) {
    throw std::runtime_error(func + " error: " + SDL_GetError());
 }
@@ -47,7 +58,7 @@ void glad_callback(const char *name, void *, int, ...) {
 void consume_errors(std::string_view context, logs &logs) {
    GLenum ec;
    while ((ec = glad_glGetError()) != GL_NO_ERROR) {
-      logs.add("OpenGL error inside ", context, ": 0x", std::hex, ec);
+      logs.add("OpenGL error inside {}: {}", context, log_hex{ec});
    }
 }
 
@@ -63,6 +74,9 @@ asp::po_desc_t window::options::prepare() {
        ("full-screen", "Start in full screen")
        ("width", po::value<int>()->default_value(1280), "Window width")
        ("height", po::value<int>()->default_value(900), "Window height")
+       ("on-change", "Only redraw if new data has arrived, or on input (implies --ingest-thread)")
+       ("max-fps", po::value<int>()->default_value(0), "Frame rate limit (0 - vsync only)")
+       ("gpu-lines", "Keep the plot lines in GPU buffers and draw them natively (OpenGL 3 and GLES 3 only)")
        ;
    // clang-format on
 
@@ -70,17 +84,22 @@ asp::po_desc_t window::options::prepare() {
 }
 
 window::options window::options::load(po_vars_t &vm) {
-   auto full_screen = vm.count("full-screen") != 0;
-   auto width = vm["width"].as<int>();
-   auto height = vm["height"].as<int>();
-
-   return ui::window::options{full_screen, width, height};
+   ui::window::options opts;
+   opts.full_screen = vm.count("full-screen") != 0;
+   opts.width = vm["width"].as<int>();
+   opts.height = vm["height"].as<int>();
+   opts.on_change = vm.count("on-change") != 0;
+   opts.max_fps = vm["max-fps"].as<int>();
+   opts.gpu_lines = vm.count("gpu-lines") != 0;
+   return opts;
 }
 
 window::window(const asp::options &opts,
                logs &logs,
+               diagnostics &diagnostics,
                std::initializer_list<ui::drawable *> drawables)
    : options_{opts.window}
+   , diagnostics_{&diagnostics}
    , drawables_{drawables} {
    // Setup SDL
    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -143,16 +162,33 @@ window::window(const asp::options &opts,
       suffix = " ES";
    }
 
-   logs.add("OpenGL version: ", GLVersion.major, ".", GLVersion.minor, suffix);
+   logs.add("OpenGL version: {}.{}{}", GLVersion.major, GLVersion.minor,
+            suffix);
    std::cout << "OpenGL version: " << GLVersion.major << "." << GLVersion.minor
              << suffix << std::endl;
 
-   frontend_ = std::make_unique<render::frontend>(*window_, context_);
+   frontend_ = std::make_unique<render::frontend>(*window_, context_,
+                                                  options_.gpu_lines);
 
    consume_errors("imgui", logs);
+
+   if (options_.gpu_lines && !frontend_->lines()) {
+      logs.add("GPU lines need OpenGL 3 or GLES 3, drawing with ImPlot");
+   }
+
+   if (options_.max_fps > 0) {
+      frame_interval_ = std::chrono::duration_cast<clock_t::duration>(
+          std::chrono::duration<double>(1.0 / options_.max_fps));
+   }
+
+   const auto event_type = SDL_RegisterEvents(1);
+   if (event_type != static_cast<Uint32>(-1)) {
+      wake_event.store(event_type);
+   }
 }
 
 window::~window() {
+   wake_event.store(0);
    frontend_.reset();
 
    if (context_ != nullptr) {
@@ -166,23 +202,35 @@ window::~window() {
    }
 }
 
-void window::update() {
-   while (SDL_PollEvent(&event_)) {
-      frontend_->process_event(event_);
-      if (event_.type == SDL_QUIT) {
-         stop_ = true;
-      } else if (event_.type == SDL_KEYUP) {
-         if (event_.key.keysym.sym == SDLK_AC_BACK ||
-             event_.key.keysym.sym == SDLK_ESCAPE) {
-            stop_ = true;
-         }
-      } else if (event_.type == SDL_WINDOWEVENT) {
-         switch (event_.window.event) {
-            case (SDL_WINDOWEVENT_RESIZED):
-               SDL_GetWindowSize(window_, &options_.width, &options_.height);
-               break;
-         }
-      }
+bool window::update(bool render) {
+   if (!render) {
+      process_events(0);
+      return false;
+   }
+
+   const bool idle = options_.on_change && redraw_frames_ == 0;
+
+   int timeout_ms = 0;
+   if (hidden_) {
+      timeout_ms = options_.on_change ? idle_wait_ms : hidden_poll_ms;
+   } else if (idle) {
+      timeout_ms = idle_wait_ms;
+   } else if (clock_t::now() < next_frame_) {
+      using namespace std::chrono;
+      const auto left = ceil<milliseconds>(next_frame_ - clock_t::now());
+      timeout_ms = std::max(static_cast<int>(left.count()), 1);
+   }
+
+   if (max_wait_ms_ >= 0) {
+      timeout_ms = std::min(timeout_ms, max_wait_ms_);
+   }
+
+   process_events(timeout_ms);
+
+   const auto now = clock_t::now();
+   if (hidden_ || now < next_frame_ ||
+       (options_.on_change && redraw_frames_ == 0)) {
+      return false;
    }
 
    if (ImGui::GetIO().WantTextInput) {
@@ -191,18 +239,121 @@ void window::update() {
       SDL_StopTextInput();
    }
 
-   frontend_->new_frame();
-
+   auto &profiler = diagnostics_->profiler();
    auto &io = ImGui::GetIO();
-   glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
-   glClearColor(clear_color_.x, clear_color_.y, clear_color_.z, clear_color_.w);
-   glClear(GL_COLOR_BUFFER_BIT);
+   {
+      const auto timer = profiler.measure(frame_stage::ui);
+      frontend_->new_frame();
+
+      glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
+      glClearColor(clear_color_.x, clear_color_.y, clear_color_.z,
+                   clear_color_.w);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      draw();
+   }
+
+   {
+      const auto timer = profiler.measure(frame_stage::render);
+      frontend_->render();
+   }
+   const auto drawn = clock_t::now();
+
+   {
+      const auto timer = profiler.measure(frame_stage::swap);
+      SDL_GL_SwapWindow(window_);
+   }
+   diagnostics_->frame_swapped();
+
+   last_frame_.draw = drawn - now;
+   last_frame_.swapped = clock_t::now();
+
+   next_frame_ = now + frame_interval_;
+   if (redraw_frames_ > 0) {
+      --redraw_frames_;
+   }
+
+   // Keep drawing while something is animated: text input cursor, dragging
+   if (io.WantTextInput || ImGui::IsAnyItemActive()) {
+      redraw_frames_ = std::max(redraw_frames_, 1);
+   }
+
+   return true;
+}
+
+void window::request_redraw() {
+   // ImGui needs a couple of frames to settle after a change
+   constexpr int settle_frames = 3;
+   redraw_frames_ = std::max(redraw_frames_, settle_frames);
+}
+
+void window::wake() {
+   const auto type = wake_event.load();
+   if (type == 0) {
+      return;
+   }
+
+   SDL_Event event{};
+   event.type = type;
+   SDL_PushEvent(&event);
+}
 
-   draw();
+void window::process_events(int timeout_ms) {
+   auto &profiler = diagnostics_->profiler();
+   SDL_Event event;
 
-   frontend_->render();
+   // The waiting is idle time, not a part of the events stage
+   int pending;
+   if (timeout_ms > 0) {
+      pending = SDL_WaitEventTimeout(&event, timeout_ms);
+      profiler.begin(frame_stage::events);
+   } else {
+      profiler.begin(frame_stage::events);
+      pending = SDL_PollEvent(&event);
+   }
 
-   SDL_GL_SwapWindow(window_);
+   while (pending) {
+      process_event(event);
+      pending = SDL_PollEvent(&event);
+   }
+   profiler.end();
+}
+
+void window::process_event(const SDL_Event &event) {
+   if (event.type == wake_event.load()) {
+      // Only interrupts the waiting, the caller decides if there is a change
+      return;
+   }
+
+   frontend_->process_event(event);
+   request_redraw();
+
+   if (event.type == SDL_QUIT) {
+      stop_ = true;
+   } else if (event.type == SDL_KEYUP) {
+      if (event.key.keysym.sym == SDLK_AC_BACK ||
+          event.key.keysym.sym == SDLK_ESCAPE) {
+         stop_ = true;
+      }
+   } else if (event.type == SDL_WINDOWEVENT) {
+      switch (event.window.event) {
+         case (SDL_WINDOWEVENT_RESIZED):
+            SDL_GetWindowSize(window_, &options_.width, &options_.height);
+            break;
+
+         case (SDL_WINDOWEVENT_MINIMIZED):
+         case (SDL_WINDOWEVENT_HIDDEN):
+            hidden_ = true;
+            break;
+
+         case (SDL_WINDOWEVENT_RESTORED):
+         case (SDL_WINDOWEVENT_MAXIMIZED):
+         case (SDL_WINDOWEVENT_SHOWN):
+         case (SDL_WINDOWEVENT_EXPOSED):
+            hidden_ = false;
+            break;
+      }
+   }
 }
 
 void window::draw() {
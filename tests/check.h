@@ -0,0 +1,26 @@
+/**
+ * @file   check.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef ASP_TESTS_CHECK_H
+#define ASP_TESTS_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace asp::tests {
+
+//! Unlike assert, stays enabled in the release builds
+inline void check(bool ok, const char *expr, const char *file, int line) {
+   if (!ok) {
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+      std::exit(EXIT_FAILURE);
+   }
+}
+
+} // namespace asp::tests
+
+#define ASP_CHECK(expr) ::asp::tests::check((expr), #expr, __FILE__, __LINE__)
+
+#endif /* ASP_TESTS_CHECK_H */
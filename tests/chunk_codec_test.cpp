@@ -0,0 +1,157 @@
+/**
+ * @file   chunk_codec_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/inputs/chunk_codec.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace asp::inputs;
+
+namespace {
+
+//! Sealed chunks hold that many values
+constexpr std::size_t chunk_size = 4096;
+
+//! Encode and decode the values, comparing the bits. Returns false if the
+//! codec refused to compress them.
+template <typename T>
+bool round_trip(const std::vector<T> &values) {
+   std::vector<std::uint8_t> encoded;
+   if (!chunk_codec<T>::encode(values.data(), values.size(), encoded)) {
+      return false;
+   }
+   ASP_CHECK(encoded.size() < values.size() * sizeof(T));
+
+   // Decoding must not depend on the output contents
+   std::vector<T> decoded(values.size());
+   std::memset(decoded.data(), 0xA5, decoded.size() * sizeof(T));
+   chunk_codec<T>::decode(encoded.data(), encoded.size(), decoded.data(),
+                          decoded.size());
+   ASP_CHECK(std::memcmp(decoded.data(), values.data(),
+                         values.size() * sizeof(T)) == 0);
+   return true;
+}
+
+template <typename T>
+std::size_t encoded_size(const std::vector<T> &values) {
+   std::vector<std::uint8_t> encoded;
+   chunk_codec<T>::encode(values.data(), values.size(), encoded);
+   return encoded.size();
+}
+
+void floats() {
+   // Constant, with runs of equal values in between changes
+   ASP_CHECK(round_trip(std::vector<float>(chunk_size, 1.5f)));
+
+   std::vector<float> runs;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      runs.push_back(static_cast<float>(i / 100));
+   }
+   ASP_CHECK(round_trip(runs));
+
+   // Slowly changing signal, with the special values in it
+   std::vector<float> signal;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      signal.push_back(std::round(std::sin(i * 0.01f) * 1000.0f) / 8.0f);
+   }
+   const auto plain_size = encoded_size(signal);
+
+   signal[10] = std::numeric_limits<float>::quiet_NaN();
+   signal[11] = std::numeric_limits<float>::infinity();
+   signal[12] = -std::numeric_limits<float>::infinity();
+   signal[13] = -0.0f;
+   signal[14] = std::numeric_limits<float>::denorm_min();
+   signal[15] = std::numeric_limits<float>::max();
+   ASP_CHECK(round_trip(signal));
+
+   // Outliers only cost a few bytes, the rest of the chunk isn't affected
+   ASP_CHECK(encoded_size(signal) < plain_size + 64);
+
+   // Random bits don't compress, the codec has to notice
+   std::mt19937 rng{1};
+   std::vector<float> noise(chunk_size);
+   for (auto &value : noise) {
+      const auto bits = static_cast<std::uint32_t>(rng());
+      std::memcpy(&value, &bits, sizeof(value));
+   }
+   ASP_CHECK(!round_trip(noise));
+}
+
+void timestamps() {
+   // Steady rate with jitter, a pause and a long gap
+   std::mt19937 rng{1};
+   std::vector<std::uint32_t> deltas;
+   std::uint32_t time = 0;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      if (i == 1000) {
+         time += 5000000;
+      } else if (i == 2000) {
+         time = std::numeric_limits<std::uint32_t>::max() - 1000000;
+      } else {
+         time += 1000 + rng() % 7;
+      }
+      deltas.push_back(time);
+   }
+   ASP_CHECK(round_trip(deltas));
+
+   // Exactly periodic, runs of the same delta
+   std::vector<std::uint32_t> periodic;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      periodic.push_back(static_cast<std::uint32_t>(i * 250));
+   }
+   ASP_CHECK(round_trip(periodic));
+
+   // Repeated timestamps: samples parsed from the same read
+   std::vector<std::uint32_t> repeated;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      repeated.push_back(static_cast<std::uint32_t>(i / 8 * 1000));
+   }
+   ASP_CHECK(round_trip(repeated));
+}
+
+void integers() {
+   // Every width, negative offsets included
+   for (const std::int64_t range : {std::int64_t{200}, std::int64_t{60000},
+                                    std::int64_t{4000000000}}) {
+      std::vector<std::int64_t> values;
+      for (std::size_t i = 0; i < chunk_size; ++i) {
+         values.push_back(-range / 2 + static_cast<std::int64_t>(i * 7919) %
+                                           (range + 1));
+      }
+      ASP_CHECK(round_trip(values));
+   }
+
+   // Range bounds, far from zero
+   const auto base = std::numeric_limits<std::int64_t>::max() - 300;
+   std::vector<std::int64_t> edges(chunk_size, base);
+   edges[1] = base + 255;
+   ASP_CHECK(round_trip(edges));
+
+   const auto low = std::numeric_limits<std::int64_t>::min();
+   ASP_CHECK(round_trip(std::vector<std::int64_t>{low, low + 65535, low}));
+
+   // Wider than 32 bits stays uncompressed
+   std::vector<std::int64_t> wide;
+   for (std::size_t i = 0; i < chunk_size; ++i) {
+      wide.push_back(static_cast<std::int64_t>(i) * 1000000000000LL);
+   }
+   ASP_CHECK(!round_trip(wide));
+}
+
+} // namespace
+
+int main() {
+   floats();
+   timestamps();
+   integers();
+   return EXIT_SUCCESS;
+}
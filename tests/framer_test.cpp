@@ -0,0 +1,142 @@
+/**
+ * @file   framer_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/inputs/framer.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace asp::inputs;
+
+namespace {
+
+using lines_t = std::vector<std::string>;
+
+//! Feed the chunks one by one, collecting the complete lines
+lines_t feed(framer &f, const std::vector<std::string> &chunks) {
+   lines_t result;
+   for (const auto &chunk : chunks) {
+      f.feed(chunk, [&](std::string_view line) { result.emplace_back(line); });
+   }
+   return result;
+}
+
+//! Straightforward framing of the whole input, the incomplete tail is
+//! returned in rest
+lines_t reference(const std::string &input, const std::string &separator,
+                  std::string &rest) {
+   lines_t result;
+   std::size_t from = 0;
+   std::size_t to;
+   while ((to = input.find(separator, from)) != std::string::npos) {
+      result.push_back(input.substr(from, to - from));
+      from = to + separator.size();
+   }
+   rest = input.substr(from);
+   return result;
+}
+
+void single_chunk() {
+   framer f{"\n"};
+   ASP_CHECK((feed(f, {"a\nbc\n\nd"}) == lines_t{"a", "bc", ""}));
+   ASP_CHECK(f.pending() == 1);
+
+   ASP_CHECK((feed(f, {"e\n"}) == lines_t{"de"}));
+   ASP_CHECK(f.pending() == 0);
+}
+
+void empty_chunks() {
+   framer f{"\r\n"};
+   ASP_CHECK((feed(f, {"", "a", "", "\r", "", "\n", ""}) == lines_t{"a"}));
+   ASP_CHECK(f.pending() == 0);
+}
+
+void split_separator() {
+   // Every split point of a multi-byte separator, including the one where the
+   // separator starts right at the chunk boundary
+   const std::string separator = "<|>";
+   const std::string input = "ab<|>cd<|>";
+   for (std::size_t i = 0; i <= input.size(); ++i) {
+      framer f{separator};
+      const auto lines = feed(f, {input.substr(0, i), input.substr(i)});
+      ASP_CHECK((lines == lines_t{"ab", "cd"}));
+      ASP_CHECK(f.pending() == 0);
+   }
+
+   // One byte at a time, the separator spans three chunks
+   framer f{separator};
+   std::vector<std::string> bytes;
+   for (const auto c : input) {
+      bytes.emplace_back(1, c);
+   }
+   ASP_CHECK((feed(f, bytes) == lines_t{"ab", "cd"}));
+}
+
+void partial_separator() {
+   // Separator prefixes that don't continue are a part of the line
+   framer f{"\r\n"};
+   ASP_CHECK((feed(f, {"a\r", "b\r", "\r\n"}) == lines_t{"a\rb\r"}));
+
+   framer g{"<|>"};
+   ASP_CHECK((feed(g, {"x<", "|", "y<|", "<|>"}) == lines_t{"x<|y<|"}));
+   ASP_CHECK(g.pending() == 0);
+}
+
+void separator_change() {
+   framer f{"\n"};
+   ASP_CHECK((feed(f, {"a\nb;c;d"}) == lines_t{"a"}));
+
+   lines_t lines;
+   f.set_separator(";", [&](std::string_view line) {
+      lines.emplace_back(line);
+   });
+   ASP_CHECK((lines == lines_t{"b", "c"}));
+   ASP_CHECK(f.pending() == 1);
+}
+
+void random_input() {
+   const std::vector<std::string> separators{"\n", "\r\n", "\n\r", "<|>"};
+   const std::string alphabet = "ab\r\n<|>";
+
+   std::mt19937 rng{1};
+   for (int iteration = 0; iteration < 5000; ++iteration) {
+      const auto &separator = separators[rng() % separators.size()];
+
+      std::string input;
+      const auto size = rng() % 200;
+      for (std::size_t i = 0; i < size; ++i) {
+         input += alphabet[rng() % alphabet.size()];
+      }
+
+      std::vector<std::string> chunks;
+      for (std::size_t i = 0; i < input.size();) {
+         const auto chunk = std::min<std::size_t>(1 + rng() % 7,
+                                                  input.size() - i);
+         chunks.push_back(input.substr(i, chunk));
+         i += chunk;
+      }
+
+      framer f{separator};
+      std::string rest;
+      ASP_CHECK(feed(f, chunks) == reference(input, separator, rest));
+      ASP_CHECK(f.pending() == rest.size());
+   }
+}
+
+} // namespace
+
+int main() {
+   single_chunk();
+   empty_chunks();
+   split_separator();
+   partial_separator();
+   separator_change();
+   random_input();
+   return EXIT_SUCCESS;
+}
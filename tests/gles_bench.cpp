@@ -0,0 +1,205 @@
+/**
+ * @file   gles_bench.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "headless_gl.h"
+
+#include <asp/render/detail/imgui_impl_sdl_es2.h>
+#include <asp/render/detail/imgui_impl_sdl_es3.h>
+
+#include <glad/glad.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Frame times of the bundled GLES renderers on a synthetic ImGui frame,
+// rendered offscreen through a surfaceless EGL context. Usage:
+//    gles-bench es2|es3 [quad size, px]
+// Run with LIBGL_ALWAYS_SOFTWARE=1 to measure Mesa's llvmpipe. The output
+// ends with a framebuffer hash, equal hashes mean identical images.
+
+using asp::tests::headless_gl;
+
+namespace {
+
+constexpr int width = 1280;
+constexpr int height = 900;
+
+//! Shape of the synthetic frame: lists of small commands, with runs of
+//! commands sharing the texture and the clip rect, like ImPlot items and
+//! ImGui widgets produce
+constexpr int list_count = 8;
+constexpr int commands_per_list = 400;
+constexpr int quads_per_command = 20;
+constexpr int commands_per_run = 4;
+
+constexpr int warmup_frames = 30;
+constexpr int measured_frames = 100;
+
+struct renderer {
+   bool (*init)();
+   void (*shutdown)();
+   void (*new_frame)(SDL_Window *);
+   void (*render)(ImDrawData *);
+};
+
+std::vector<std::unique_ptr<ImDrawList>> make_lists(float quad_size) {
+   const auto texture = ImGui::GetIO().Fonts->TexID;
+   const ImU32 color = 0x80FFFFFF;
+
+   std::mt19937 rng{1};
+   std::uniform_real_distribution<float> x_dist{0, width};
+   std::uniform_real_distribution<float> y_dist{0, height};
+
+   std::vector<std::unique_ptr<ImDrawList>> result;
+   for (int l = 0; l < list_count; ++l) {
+      auto list = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+      for (int c = 0; c < commands_per_list; ++c) {
+         const auto run = c / commands_per_run;
+         const auto left = static_cast<float>(run % 10 * 100);
+
+         ImDrawCmd cmd{};
+         cmd.ClipRect = ImVec4(left, 0, left + 400, height);
+         cmd.TextureId = texture;
+         cmd.IdxOffset = static_cast<unsigned int>(list->IdxBuffer.Size);
+         cmd.ElemCount = quads_per_command * 6;
+
+         for (int q = 0; q < quads_per_command; ++q) {
+            const auto x = x_dist(rng);
+            const auto y = y_dist(rng);
+            const auto base = static_cast<ImDrawIdx>(list->VtxBuffer.Size);
+
+            list->VtxBuffer.push_back({ImVec2(x, y), ImVec2(0, 0), color});
+            list->VtxBuffer.push_back(
+                {ImVec2(x + quad_size, y), ImVec2(1, 0), color});
+            list->VtxBuffer.push_back(
+                {ImVec2(x + quad_size, y + quad_size), ImVec2(1, 1), color});
+            list->VtxBuffer.push_back(
+                {ImVec2(x, y + quad_size), ImVec2(0, 1), color});
+
+            for (const int i : {0, 1, 2, 0, 2, 3}) {
+               list->IdxBuffer.push_back(static_cast<ImDrawIdx>(base + i));
+            }
+         }
+         list->CmdBuffer.push_back(cmd);
+      }
+      result.push_back(std::move(list));
+   }
+   return result;
+}
+
+std::uint64_t framebuffer_hash(const headless_gl &gl) {
+   // FNV-1a
+   std::uint64_t hash = 1469598103934665603ULL;
+   for (const auto byte : gl.read_pixels()) {
+      hash ^= byte;
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+   const bool es2 = argc > 1 && std::strcmp(argv[1], "es2") == 0;
+   const bool es3 = argc > 1 && std::strcmp(argv[1], "es3") == 0;
+   if (!es2 && !es3) {
+      std::cerr << "Usage: " << argv[0] << " es2|es3 [quad size, px]"
+                << std::endl;
+      return EXIT_FAILURE;
+   }
+   const float quad_size = argc > 2 ? std::strtof(argv[2], nullptr) : 8.0f;
+
+   const renderer impl =
+       es2 ? renderer{&ImGui_ImplSdlGLES2_Init, &ImGui_ImplSdlGLES2_Shutdown,
+                      &ImGui_ImplSdlGLES2_NewFrame,
+                      &ImGui_ImplSdlGLES2_RenderDrawLists}
+           : renderer{&ImGui_ImplSdlGLES3_Init, &ImGui_ImplSdlGLES3_Shutdown,
+                      &ImGui_ImplSdlGLES3_NewFrame,
+                      &ImGui_ImplSdlGLES3_RenderDrawLists};
+
+   try {
+      headless_gl gl{headless_gl::api::gles, es2 ? 2 : 3, 0, width, height};
+      std::cout << gl.description() << std::endl;
+
+      ImGui::CreateContext();
+      auto &io = ImGui::GetIO();
+      io.IniFilename = nullptr;
+      io.DisplaySize = ImVec2(width, height);
+      io.DisplayFramebufferScale = ImVec2(1, 1);
+
+      impl.init();
+      impl.new_frame(nullptr);
+
+      auto lists = make_lists(quad_size);
+      std::vector<ImDrawList *> pointers;
+      for (auto &list : lists) {
+         pointers.push_back(list.get());
+      }
+
+      ImDrawData data;
+      for (const auto *list : pointers) {
+         data.TotalVtxCount += list->VtxBuffer.Size;
+         data.TotalIdxCount += list->IdxBuffer.Size;
+      }
+      data.Valid = true;
+      data.CmdLists = pointers.data();
+      data.CmdListsCount = static_cast<int>(pointers.size());
+      data.DisplayPos = ImVec2(0, 0);
+      data.DisplaySize = io.DisplaySize;
+      data.FramebufferScale = io.DisplayFramebufferScale;
+
+      auto frame = [&] {
+         glViewport(0, 0, width, height);
+         glClearColor(0, 0, 0, 1);
+         glClear(GL_COLOR_BUFFER_BIT);
+         impl.render(&data);
+         glFinish();
+      };
+
+      for (int i = 0; i < warmup_frames; ++i) {
+         frame();
+      }
+
+      using clock_t = std::chrono::steady_clock;
+      using ms_t = std::chrono::duration<double, std::milli>;
+
+      std::vector<double> times;
+      for (int i = 0; i < measured_frames; ++i) {
+         const auto start = clock_t::now();
+         frame();
+         times.push_back(ms_t(clock_t::now() - start).count());
+      }
+
+      std::sort(times.begin(), times.end());
+      double sum = 0;
+      for (const auto t : times) {
+         sum += t;
+      }
+
+      std::cout << "frame ms: avg " << sum / measured_frames << " p50 "
+                << times[measured_frames / 2] << " p99 "
+                << times[measured_frames * 99 / 100] << ", GL error "
+                << glGetError() << std::endl;
+      std::cout << "framebuffer hash " << std::hex << framebuffer_hash(gl)
+                << std::endl;
+
+      impl.shutdown();
+      ImGui::DestroyContext();
+   } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
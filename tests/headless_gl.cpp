@@ -0,0 +1,117 @@
+/**
+ * @file   headless_gl.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "headless_gl.h"
+
+#include <glad/glad.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <stdexcept>
+
+using namespace asp::tests;
+
+namespace {
+
+[[noreturn]] void throw_egl(const char *what) {
+   throw std::runtime_error(std::string{what} + " failed, EGL error " +
+                            std::to_string(eglGetError()));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Class: headless_gl
+////////////////////////////////////////////////////////////////////////////////
+headless_gl::headless_gl(api type, int major, int minor, int width,
+                         int height)
+   : width_{width}
+   , height_{height} {
+   const auto get_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+       eglGetProcAddress("eglGetPlatformDisplayEXT"));
+   if (!get_display) {
+      throw std::runtime_error("eglGetPlatformDisplayEXT is not supported");
+   }
+
+   const auto display = get_display(EGL_PLATFORM_SURFACELESS_MESA,
+                                    EGL_DEFAULT_DISPLAY, nullptr);
+   if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+      throw_egl("eglInitialize");
+   }
+   display_ = display;
+
+   const bool es = type == api::gles;
+   if (!eglBindAPI(es ? EGL_OPENGL_ES_API : EGL_OPENGL_API)) {
+      throw_egl("eglBindAPI");
+   }
+
+   std::vector<EGLint> attributes{EGL_CONTEXT_MAJOR_VERSION, major,
+                                  EGL_CONTEXT_MINOR_VERSION, minor};
+   if (!es) {
+      attributes.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK);
+      attributes.push_back(EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT);
+   }
+   attributes.push_back(EGL_NONE);
+
+   // Surfaceless contexts don't need a config (EGL_KHR_no_config_context)
+   const auto context = eglCreateContext(display, EGL_NO_CONFIG_KHR,
+                                         EGL_NO_CONTEXT, attributes.data());
+   if (context == EGL_NO_CONTEXT) {
+      throw_egl("eglCreateContext");
+   }
+   context_ = context;
+
+   if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+      throw_egl("eglMakeCurrent");
+   }
+
+   if (gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)) ==
+       0) {
+      throw std::runtime_error("gladLoadGLLoader failed");
+   }
+
+   glGenFramebuffers(1, &framebuffer_);
+   glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+   glGenRenderbuffers(1, &renderbuffer_);
+   glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer_);
+   glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+   glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                             GL_RENDERBUFFER, renderbuffer_);
+   if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+      throw std::runtime_error("Offscreen framebuffer is incomplete");
+   }
+
+   glViewport(0, 0, width_, height_);
+}
+
+headless_gl::~headless_gl() {
+   if (framebuffer_) {
+      glDeleteFramebuffers(1, &framebuffer_);
+      glDeleteRenderbuffers(1, &renderbuffer_);
+   }
+
+   eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+   eglDestroyContext(display_, context_);
+   eglTerminate(display_);
+}
+
+std::string headless_gl::description() const {
+   auto str = [](GLenum name) {
+      const auto value = glGetString(name);
+      return value ? std::string{reinterpret_cast<const char *>(value)}
+                   : std::string{};
+   };
+   return str(GL_RENDERER) + " | " + str(GL_VERSION);
+}
+
+std::vector<unsigned char> headless_gl::read_pixels() const {
+   std::vector<unsigned char> result(
+       static_cast<std::size_t>(width_) * height_ * 4);
+   glReadPixels(0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE,
+                result.data());
+   return result;
+}
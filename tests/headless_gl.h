@@ -0,0 +1,50 @@
+/**
+ * @file   headless_gl.h
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+#ifndef ASP_TESTS_HEADLESS_GL_H
+#define ASP_TESTS_HEADLESS_GL_H
+
+#include <string>
+#include <vector>
+
+namespace asp::tests {
+
+//! GL context without a window or a display server: a surfaceless EGL
+//! context, rendering into an offscreen RGBA framebuffer. Meant for Mesa's
+//! llvmpipe, so the renderers can be checked on machines without a GPU.
+class headless_gl {
+public:
+   enum class api { gl, gles };
+
+public:
+   //! Desktop GL contexts use the core profile
+   headless_gl(api type, int major, int minor, int width, int height);
+   ~headless_gl();
+
+   headless_gl(const headless_gl &) = delete;
+   headless_gl &operator=(const headless_gl &) = delete;
+
+public:
+   //! GL_RENDERER and GL_VERSION strings
+   std::string description() const;
+
+   //! Framebuffer contents, bottom row first
+   std::vector<unsigned char> read_pixels() const;
+
+   int width() const { return width_; }
+   int height() const { return height_; }
+
+private:
+   void *display_{nullptr};
+   void *context_{nullptr};
+   unsigned int framebuffer_{0};
+   unsigned int renderbuffer_{0};
+   int width_;
+   int height_;
+};
+
+} // namespace asp::tests
+
+#endif /* ASP_TESTS_HEADLESS_GL_H */
@@ -0,0 +1,143 @@
+/**
+ * @file   line_renderer_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+#include "headless_gl.h"
+
+#include <asp/render/line_renderer.h>
+
+#include <glad/glad.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace asp::render;
+using asp::tests::headless_gl;
+
+namespace {
+
+constexpr int width = 200;
+constexpr int height = 100;
+
+//! Plot area, the lines are clipped to it
+constexpr float clip_left = 10;
+constexpr float clip_right = 190;
+
+//! Opaque red, in the ImGui (ABGR) order
+constexpr std::uint32_t red = 0xFF0000FF;
+
+void run(headless_gl::api api, int major, int minor,
+         const char *shader_version) {
+   headless_gl gl{api, major, minor, width, height};
+   std::cout << gl.description() << std::endl;
+
+   ImGui::CreateContext();
+   auto &io = ImGui::GetIO();
+   io.IniFilename = nullptr;
+   io.DisplaySize = ImVec2(width, height);
+
+   unsigned char *pixels = nullptr;
+   int atlas_width = 0;
+   int atlas_height = 0;
+   io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+
+   {
+      line_renderer renderer{shader_version, api == headless_gl::api::gles};
+      line_buffer buffer;
+
+      // Two appends past the initial capacity, so the buffer has to grow
+      std::vector<line_buffer::vertex> vertices(5000);
+      for (std::size_t i = 0; i < vertices.size(); ++i) {
+         vertices[i] = {static_cast<float>(i), 0.0f};
+      }
+
+      buffer.reset(1000, 1000.0);
+      buffer.append(vertices.data(), 3000);
+      buffer.append(vertices.data() + 3000, 2000);
+      ASP_CHECK(buffer.first_index() == 1000);
+      ASP_CHECK(buffer.end_index() == 6000);
+
+      ImGui::NewFrame();
+      renderer.new_frame();
+
+      auto &draw_list = *ImGui::GetBackgroundDrawList();
+      draw_list.PushClipRect(ImVec2(clip_left, 0), ImVec2(clip_right, height));
+
+      // 25 samples per pixel across the whole width, on the middle row
+      const line_renderer::transform xform{0.04, 0.0, -1.0, height / 2.0};
+      renderer.draw(draw_list, buffer, 1000, 5000, xform, red);
+
+      // Samples the buffer doesn't hold are skipped
+      renderer.draw(draw_list, buffer, 999, 10, xform, red);
+      ASP_CHECK(renderer.draw_calls() == 1);
+
+      draw_list.PopClipRect();
+      ImGui::Render();
+
+      glClearColor(0, 0, 0, 1);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      const auto &data = *ImGui::GetDrawData();
+      for (int i = 0; i < data.CmdListsCount; ++i) {
+         const auto *list = data.CmdLists[i];
+         for (const auto &cmd : list->CmdBuffer) {
+            if (cmd.UserCallback &&
+                cmd.UserCallback != ImDrawCallback_ResetRenderState) {
+               cmd.UserCallback(list, &cmd);
+            }
+         }
+      }
+      ASP_CHECK(glGetError() == GL_NO_ERROR);
+   }
+
+   // Rows are counted from the bottom
+   int count = 0;
+   int left = width;
+   int right = -1;
+   int bottom = height;
+   int top = -1;
+   const auto framebuffer = gl.read_pixels();
+   for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+         const auto *pixel = &framebuffer[(y * width + x) * 4];
+         if (pixel[0] > 200 && pixel[1] < 50 && pixel[2] < 50) {
+            ++count;
+            left = std::min(left, x);
+            right = std::max(right, x);
+            bottom = std::min(bottom, y);
+            top = std::max(top, y);
+         }
+      }
+   }
+
+   std::cout << count << " pixels, x " << left << ".." << right << ", y "
+             << bottom << ".." << top << std::endl;
+
+   // A single horizontal line, exactly filling the clip rect
+   ASP_CHECK(left == static_cast<int>(clip_left));
+   ASP_CHECK(right == static_cast<int>(clip_right) - 1);
+   ASP_CHECK(top - bottom <= 1);
+   ASP_CHECK(std::abs(bottom - height / 2) <= 1);
+
+   ImGui::DestroyContext();
+}
+
+} // namespace
+
+int main() {
+   try {
+      run(headless_gl::api::gl, 3, 2, "#version 150");
+      run(headless_gl::api::gles, 3, 0, "#version 300 es");
+   } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file   log_record_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/ui/log_record.h>
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+using namespace asp::ui;
+
+namespace {
+
+template <typename... ARGS>
+std::string format(const char *fmt, const ARGS &...args) {
+   std::string result;
+   log_record::make(fmt, args...).format_to(result);
+   return result;
+}
+
+void arguments() {
+   ASP_CHECK(format("no arguments") == "no arguments");
+   ASP_CHECK(format("{} {} {}", -5, 7u, std::int64_t{-1}) == "-5 7 -1");
+   ASP_CHECK(format("{}", std::numeric_limits<std::int64_t>::min()) ==
+             "-9223372036854775808");
+   ASP_CHECK(format("{}", std::numeric_limits<std::uint64_t>::max()) ==
+             "18446744073709551615");
+   ASP_CHECK(format("{}", log_hex{0xBEEF}) == "0xbeef");
+   ASP_CHECK(format("{} {}", 1.5, 0.25f) == "1.5 0.25");
+   ASP_CHECK(format("[{}]", "text") == "[text]");
+   ASP_CHECK(format("[{}]", std::string{"string"}) == "[string]");
+   ASP_CHECK(format("{}{}", "a", 1) == "a1");
+}
+
+void placeholders() {
+   // Missing arguments stay placeholders, extra ones are ignored
+   ASP_CHECK(format("{} and {}", 1) == "1 and {}");
+   ASP_CHECK(format("{}", 1, 2) == "1");
+
+   // Arguments are not formats themselves
+   ASP_CHECK(format("{} {}", "{}", 2) == "{} 2");
+
+   // Only max_args arguments are captured
+   ASP_CHECK(format("{}{}{}{}{}{}{}", 1, 2, 3, 4, 5, 6, 7) == "123456{}");
+}
+
+void text_limit() {
+   // Strings share the text buffer, the ones past its end are cut
+   const std::string long_text(log_record::text_size - 10, 'x');
+   const auto result = format("{}|{}|{}", long_text, "0123456789abc", "z");
+   ASP_CHECK(result == long_text + "|0123456789|");
+}
+
+void stored_prefix() {
+   // Only the used part of the text is stored by the log panel, the rest of
+   // the record has to be restored from it
+   const auto record = log_record::make("{}: {}", "name", 42);
+   const auto size = offsetof(log_record, text) + record.text_used;
+
+   log_record copy;
+   std::memset(&copy, 0xFF, sizeof(copy));
+   std::memcpy(&copy, &record, size);
+
+   std::string result;
+   copy.format_to(result);
+   ASP_CHECK(result == "name: 42");
+}
+
+} // namespace
+
+int main() {
+   arguments();
+   placeholders();
+   text_limit();
+   stored_prefix();
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file   logs_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/ui/logs.h>
+
+#include <memory>
+#include <string>
+
+using namespace asp::ui;
+
+namespace {
+
+//! Fewer than the queue holds, so nothing is lost between the drains
+constexpr int drain_every = 500;
+
+//! Entry text, a payload of a varying size up to the record's text limit
+std::string payload(int idx) {
+   const auto size = static_cast<std::size_t>(idx * 37) %
+                     (log_record::text_size + 1);
+   return std::string(size, static_cast<char>('a' + idx % 26));
+}
+
+std::string expected(int idx, bool with_payload) {
+   return "entry " + std::to_string(idx) + " " +
+          (with_payload ? payload(idx) : std::string{});
+}
+
+//! Add count entries, numbered from first, draining regularly
+void fill(logs &l, int first, int count, bool with_payload) {
+   for (int i = first; i < first + count; ++i) {
+      l.add("entry {} {}", i, with_payload ? payload(i) : std::string{});
+      if (i % drain_every == drain_every - 1) {
+         l.drain();
+      }
+   }
+   l.drain();
+}
+
+//! The newest of the total entries added are kept, in order and intact
+void check_tail(logs &l, int total, bool with_payload) {
+   ASP_CHECK(l.size() > 0);
+   ASP_CHECK(l.size() + l.dropped() == static_cast<std::uint64_t>(total));
+
+   const auto first = total - static_cast<int>(l.size());
+   for (std::size_t i = 0; i < l.size(); ++i) {
+      const auto idx = first + static_cast<int>(i);
+      ASP_CHECK(l.line(i) == expected(idx, with_payload));
+   }
+}
+
+void entry_ring_wraps() {
+   // Short entries: the entry ring is the limit, not the arena
+   auto l = std::make_unique<logs>();
+   const int count = 250000;
+   fill(*l, 0, count, false);
+   ASP_CHECK(l->dropped() > 0);
+   check_tail(*l, count, false);
+}
+
+void arena_wraps() {
+   // Long entries of varying sizes: the arena is the limit, and the entries
+   // that don't fit at its end are written at the start
+   auto l = std::make_unique<logs>();
+   const int count = 100000;
+   fill(*l, 0, count, true);
+   ASP_CHECK(l->dropped() > 0);
+   check_tail(*l, count, true);
+
+   // Keeps working after many more wraps
+   fill(*l, count, count, true);
+   check_tail(*l, count * 2, true);
+}
+
+void full_queue() {
+   // Messages past the queue capacity are counted, not blocked on
+   auto l = std::make_unique<logs>();
+   for (int i = 0; i < 3000; ++i) {
+      l->add("entry {} {}", i, "");
+   }
+   ASP_CHECK(l->dropped() > 0);
+
+   l->drain();
+   ASP_CHECK(l->size() + l->dropped() == 3000);
+   ASP_CHECK(l->line(0) == "entry 0 ");
+}
+
+} // namespace
+
+int main() {
+   entry_ring_wraps();
+   arena_wraps();
+   full_queue();
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file   sliding_extents_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/inputs/channels.h>
+#include <asp/inputs/sliding_extents.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace asp::inputs;
+
+namespace {
+
+void basic() {
+   sliding_extents e;
+   ASP_CHECK(e.empty());
+
+   e.push(0, 3);
+   e.push(1, 1);
+   e.push(2, 2);
+   ASP_CHECK(e.min() == 1 && e.max() == 3);
+
+   // Maximum leaves the window, the minimum stays
+   e.evict(1);
+   ASP_CHECK(e.min() == 1 && e.max() == 2);
+
+   e.evict(3);
+   ASP_CHECK(e.empty());
+
+   e.push(3, 5);
+   e.clear();
+   ASP_CHECK(e.empty());
+}
+
+void equal_values() {
+   // Equal values replace the older ones, so evicting those keeps the range
+   sliding_extents e;
+   e.push(0, 1);
+   e.push(1, 1);
+   e.push(2, 1);
+   e.evict(2);
+   ASP_CHECK(!e.empty() && e.min() == 1 && e.max() == 1);
+}
+
+void nan_skipped() {
+   sliding_extents e;
+   e.push(0, NAN);
+   ASP_CHECK(e.empty());
+
+   e.push(1, 4);
+   e.push(2, NAN);
+   e.push(3, -4);
+   ASP_CHECK(e.min() == -4 && e.max() == 4);
+}
+
+void random_window() {
+   // Gaps in the indices, as with the samples of a single channel
+   std::mt19937 rng{1};
+   std::uniform_real_distribution<float> values{-100, 100};
+
+   std::vector<std::pair<std::uint64_t, float>> samples;
+   std::uint64_t index = 0;
+   for (int i = 0; i < 20000; ++i) {
+      index += 1 + rng() % 3;
+      samples.emplace_back(index, values(rng));
+   }
+
+   for (const std::uint64_t window : {1, 7, 100, 5000}) {
+      sliding_extents e;
+      for (std::size_t i = 0; i < samples.size(); ++i) {
+         const auto [idx, value] = samples[i];
+         e.push(idx, value);
+
+         const auto first = idx >= window ? idx - window + 1 : 0;
+         e.evict(first);
+
+         float min = value;
+         float max = value;
+         for (auto j = i; j-- > 0 && samples[j].first >= first;) {
+            min = std::min(min, samples[j].second);
+            max = std::max(max, samples[j].second);
+         }
+         ASP_CHECK(e.min() == min && e.max() == max);
+      }
+   }
+}
+
+void store_window() {
+   channel_store store;
+   const auto a = store.intern("a");
+   const auto b = store.intern("b");
+
+   // Last three samples, counted by the largest end index
+   store.set_window({3, {}});
+   for (int i = 0; i < 10; ++i) {
+      store.append(a, static_cast<float>(i));
+   }
+   store.append(b, -1);
+
+   auto range = store.window_range(a);
+   ASP_CHECK(range && range->first == 7 && range->second == 9);
+
+   // Channel b has no samples in the window: its only sample has index 0
+   ASP_CHECK(!store.window_range(b));
+
+   // Growing the window rescans the retained samples
+   store.set_window({5, {}});
+   range = store.window_range(a);
+   ASP_CHECK(range && range->first == 5 && range->second == 9);
+
+   store.set_window({});
+   ASP_CHECK(!store.window_range(a));
+}
+
+} // namespace
+
+int main() {
+   basic();
+   equal_values();
+   nan_skipped();
+   random_window();
+   store_window();
+   return EXIT_SUCCESS;
+}
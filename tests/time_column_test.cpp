@@ -0,0 +1,120 @@
+/**
+ * @file   time_column_test.cpp
+ * @author Dennis Sitelew
+ * @date   Oct. 18, 2026
+ */
+
+#include "check.h"
+
+#include <asp/inputs/time_column.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace asp::inputs;
+
+namespace {
+
+using time_point = time_column::time_point;
+using us = std::chrono::microseconds;
+
+//! Largest delta an epoch can hold
+constexpr us epoch_span{std::numeric_limits<std::uint32_t>::max()};
+
+//! Lower bound over the retained part of the pushed timestamps
+std::uint64_t reference(const time_column &column,
+                        const std::vector<time_point> &times,
+                        time_point time) {
+   const auto first = times.begin() + column.first_index();
+   return static_cast<std::uint64_t>(
+       std::lower_bound(first, times.end(), time) - times.begin());
+}
+
+void epoch_boundary() {
+   const time_point start{std::chrono::hours(1)};
+
+   // The largest delta still fits, one more microsecond starts a new epoch
+   time_column column;
+   column.push_back(start);
+   column.push_back(start + epoch_span);
+   column.push_back(start + epoch_span + us(1));
+   column.push_back(start + epoch_span * 3);
+
+   ASP_CHECK(column.at(0) == start);
+   ASP_CHECK(column.at(1) == start + epoch_span);
+   ASP_CHECK(column.at(2) == start + epoch_span + us(1));
+   ASP_CHECK(column.at(3) == start + epoch_span * 3);
+
+   ASP_CHECK(column.lower_bound(start + epoch_span) == 1);
+   ASP_CHECK(column.lower_bound(start + epoch_span + us(1)) == 2);
+   ASP_CHECK(column.lower_bound(start + epoch_span * 2) == 3);
+   ASP_CHECK(column.lower_bound(start + epoch_span * 4) == 4);
+
+   // Dropping the first epoch keeps the later ones intact
+   column.drop_front(2);
+   ASP_CHECK(column.front() == start + epoch_span + us(1));
+   ASP_CHECK(column.back() == start + epoch_span * 3);
+   ASP_CHECK(column.lower_bound(start) == 2);
+}
+
+void clock_going_back() {
+   const time_point start{std::chrono::seconds(10)};
+
+   time_column column;
+   column.push_back(start);
+   column.push_back(start - us(5));
+   ASP_CHECK(column.at(1) == start);
+}
+
+void random_epochs() {
+   std::mt19937_64 rng{1};
+
+   for (int round = 0; round < 4; ++round) {
+      // Limited and unlimited sizes, plain and compressed chunks
+      time_column column{round % 2 ? std::size_t{30000} : 0};
+      if (round >= 2) {
+         column.set_compression(4096);
+      }
+
+      std::vector<time_point> times;
+      time_point time{};
+      for (int i = 0; i < 50000; ++i) {
+         // Occasional gaps longer than an epoch
+         time += i % 9000 == 0 ? epoch_span + us(rng() % 1000000)
+                               : us(rng() % 300);
+         column.push_back(time);
+         times.push_back(time);
+      }
+
+      if (round == 0) {
+         column.drop_front(12345);
+      }
+
+      for (auto idx = column.first_index(); idx < column.end_index(); ++idx) {
+         ASP_CHECK(column.at(idx) == times[idx]);
+      }
+
+      for (int probe = 0; probe < 2000; ++probe) {
+         const auto &sample = times[rng() % times.size()];
+         const auto time = sample + us(static_cast<int>(rng() % 3) - 1);
+         ASP_CHECK(column.lower_bound(time) == reference(column, times, time));
+      }
+
+      ASP_CHECK(column.lower_bound(time_point{}) == column.first_index());
+      ASP_CHECK(column.lower_bound(time + us(1)) == column.end_index());
+   }
+
+   time_column empty;
+   ASP_CHECK(empty.lower_bound(time_point{}) == 0);
+}
+
+} // namespace
+
+int main() {
+   epoch_boundary();
+   clock_going_back();
+   random_epochs();
+   return EXIT_SUCCESS;
+}